@@ -4,25 +4,37 @@ in vec2 texCoord;
 in vec3 position;
 out vec4 fragColor;
 
-uniform vec3 viewPos;
-
 struct Light {
   vec3 position;
   vec3 ambient;
   vec3 diffuse;
   vec3 specular;
 };
-uniform Light light;
+
+layout (std140) uniform FrameData {
+  mat4 view;
+  mat4 projection;
+  mat4 viewProjection;
+  vec3 viewPos;
+  Light light;
+};
  
 struct Material {
   sampler2D diffuse;
   sampler2D specular;
   float shininess;
+  // 위 줄부터 저장된 texture(.dds 등)면 1: 올린 data를 고치지 않고 v를 뒤집어 읽음
+  int diffuseTopDown;
+  int specularTopDown;
 };
 uniform Material material;
 
+vec2 TexCoordFor(int topDown) {
+  return topDown != 0 ? vec2(texCoord.x, 1.0 - texCoord.y) : texCoord;
+}
+
 void main() {
-  vec3 texColor = texture2D(material.diffuse, texCoord).xyz;
+  vec3 texColor = texture2D(material.diffuse, TexCoordFor(material.diffuseTopDown)).xyz;
   vec3 ambient = texColor * light.ambient;
  
   vec3 lightDir = normalize(light.position - position);
@@ -30,7 +42,7 @@ void main() {
   float diff = max(dot(pixelNorm, lightDir), 0.0);
   vec3 diffuse = diff * texColor * light.diffuse;
 
-  vec3 specColor = texture2D(material.specular, texCoord).xyz;
+  vec3 specColor = texture2D(material.specular, TexCoordFor(material.specularTopDown)).xyz;
   vec3 viewDir = normalize(viewPos - position);
   vec3 reflectDir = reflect(-lightDir, pixelNorm);
   float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
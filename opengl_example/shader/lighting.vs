@@ -3,19 +3,55 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
-uniform mat4 transform;
+struct Light {
+  vec3 position;
+  vec3 ambient;
+  vec3 diffuse;
+  vec3 specular;
+};
+
+// 프레임마다 한 번 업로드되는 공용 uniform block (frame_uniforms.h 참고)
+layout (std140) uniform FrameData {
+  mat4 view;
+  mat4 projection;
+  mat4 viewProjection;
+  vec3 viewPos;
+  Light light;
+};
+
 uniform mat4 modelTransform;
+// transpose(inverse(mat3(modelTransform))): CPU에서 object마다 한 번 계산해서 전달
+uniform mat3 normalTransform;
+
+// 압축 정점 복원 (vertex_compression.h 참고)
+// 16bit snorm position은 [-1, 1]로 들어오므로 mesh의 bounding box로 되돌림 (float mesh는 1, 0)
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
+// normal이 octahedral encoding이면 aNormal.xy에 [-1, 1]^2 값이 들어옴
+uniform bool octahedralNormal;
+
+vec3 DecodeNormal(vec3 n) {
+  if (!octahedralNormal)
+    return n;
+  vec3 decoded = vec3(n.xy, 1.0 - abs(n.x) - abs(n.y));
+  if (decoded.z < 0.0) {
+    vec2 signs = vec2(decoded.x >= 0.0 ? 1.0 : -1.0, decoded.y >= 0.0 ? 1.0 : -1.0);
+    decoded.xy = (1.0 - abs(decoded.yx)) * signs;
+  }
+  return normalize(decoded);
+}
 
 out vec3 normal;
 out vec2 texCoord;
 out vec3 position;
 
 void main() {
+  vec3 pos = aPos * positionScale + positionOffset;
   // gl_Position : 화면 상에서 점의 좌표 (canonical space) (카메라 입장)
   // position : World coordinate에서의 점의 좌표 -> diffusion 값 계산 가능
-  gl_Position = transform * vec4(aPos, 1.0);
+  gl_Position = viewProjection * modelTransform * vec4(pos, 1.0);
   // inverse transpose를 곱하는 이유 : 점이 아닌 벡터의 변환된 값을 계산하기 위한 방법
-  normal = (transpose(inverse(modelTransform)) * vec4(aNormal, 0.0)).xyz;
+  normal = normalTransform * DecodeNormal(aNormal);
   texCoord = aTexCoord;
-  position = (modelTransform * vec4(aPos, 1.0)).xyz;
+  position = (modelTransform * vec4(pos, 1.0)).xyz;
 }
\ No newline at end of file
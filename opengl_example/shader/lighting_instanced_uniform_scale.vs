@@ -0,0 +1,51 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+// instance attribute: mat4는 location 3 ~ 6의 vec4 4개를 차지
+layout (location = 3) in mat4 aModelTransform;
+
+struct Light {
+  vec3 position;
+  vec3 ambient;
+  vec3 diffuse;
+  vec3 specular;
+};
+
+layout (std140) uniform FrameData {
+  mat4 view;
+  mat4 projection;
+  mat4 viewProjection;
+  vec3 viewPos;
+  Light light;
+};
+
+// 압축 정점 복원 (lighting.vs 참고)
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
+uniform bool octahedralNormal;
+
+vec3 DecodeNormal(vec3 n) {
+  if (!octahedralNormal)
+    return n;
+  vec3 decoded = vec3(n.xy, 1.0 - abs(n.x) - abs(n.y));
+  if (decoded.z < 0.0) {
+    vec2 signs = vec2(decoded.x >= 0.0 ? 1.0 : -1.0, decoded.y >= 0.0 ? 1.0 : -1.0);
+    decoded.xy = (1.0 - abs(decoded.yx)) * signs;
+  }
+  return normalize(decoded);
+}
+
+out vec3 normal;
+out vec2 texCoord;
+out vec3 position;
+
+void main() {
+  vec3 pos = aPos * positionScale + positionOffset;
+  gl_Position = viewProjection * aModelTransform * vec4(pos, 1.0);
+  // x, y, z scale이 같으면 inverse transpose는 mat3(model)의 상수배
+  // -> fragment shader에서 normalize하므로 그대로 사용해도 된다
+  normal = mat3(aModelTransform) * DecodeNormal(aNormal);
+  texCoord = aTexCoord;
+  position = (aModelTransform * vec4(pos, 1.0)).xyz;
+}
@@ -1,8 +1,28 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 
-uniform mat4 transform;
+struct Light {
+  vec3 position;
+  vec3 ambient;
+  vec3 diffuse;
+  vec3 specular;
+};
+
+layout (std140) uniform FrameData {
+  mat4 view;
+  mat4 projection;
+  mat4 viewProjection;
+  vec3 viewPos;
+  Light light;
+};
+
+uniform mat4 modelTransform;
+
+// 16bit snorm position 복원 (lighting.vs 참고)
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
 
 void main() {
-  gl_Position = transform * vec4(aPos, 1.0); 
+  vec3 pos = aPos * positionScale + positionOffset;
+  gl_Position = viewProjection * modelTransform * vec4(pos, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,10 @@
+#ifndef __ALLOCATION_COUNTER_H__
+#define __ALLOCATION_COUNTER_H__
+
+#include <cstdint>
+
+// 프로그램 시작 후 global operator new가 호출된 횟수
+// (allocation_counter.cpp에서 operator new/delete를 교체해서 센다)
+uint64_t GetAllocationCount();
+
+#endif // __ALLOCATION_COUNTER_H__
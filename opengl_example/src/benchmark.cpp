@@ -0,0 +1,324 @@
+#include "benchmark.h"
+#include "program.h"
+#include "allocation_counter.h"
+#include "gl_state.h"
+#include "model_importer.h"
+#include "mapped_file.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "image.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+
+FrameBenchmarkUPtr FrameBenchmark::Create(int frameCount) {
+  auto benchmark = FrameBenchmarkUPtr(new FrameBenchmark());
+  if (!benchmark->Init(frameCount))
+    return nullptr;
+  return std::move(benchmark);
+}
+
+FrameBenchmark::~FrameBenchmark() {
+  glDeleteQueries(QUERY_COUNT, m_queries);
+  glDeleteQueries(QUERY_COUNT * 2, &m_geometryQueries[0][0]);
+}
+
+bool FrameBenchmark::Init(int frameCount) {
+  if (frameCount <= 0) {
+    SPDLOG_ERROR("invalid benchmark frame count: {}", frameCount);
+    return false;
+  }
+  m_frameCount = frameCount;
+  m_cpuTimes.reserve(frameCount);
+  m_gpuTimes.reserve(frameCount);
+  m_geometryGpuTimes.reserve(frameCount);
+  glGenQueries(QUERY_COUNT, m_queries);
+  glGenQueries(QUERY_COUNT * 2, &m_geometryQueries[0][0]);
+  for (int i = 0; i < QUERY_COUNT; i++)
+    m_queryFrame[i] = -1;
+  return true;
+}
+
+/*
+GL_TIME_ELAPSED query:
+  glBeginQuery() ~ glEndQuery() 사이의 GL 명령이 GPU에서 실행된 시간(ns)을 측정
+  결과를 바로 읽으면 GPU가 끝날 때까지 CPU가 멈추므로
+  GL_QUERY_RESULT_AVAILABLE을 확인한 뒤 준비된 것만 가져온다
+*/
+void FrameBenchmark::BeginFrame() {
+  int slot = m_frameIndex % QUERY_COUNT;
+  // 한 바퀴 돌아 재사용하려는 query는 결과를 먼저 받아둬야 한다
+  if (m_queryFrame[slot] >= 0)
+    CollectQueries(true);
+  glBeginQuery(GL_TIME_ELAPSED, m_queries[slot]);
+  m_queryFrame[slot] = m_frameIndex;
+  m_frameStart = std::chrono::high_resolution_clock::now();
+  m_frameAllocationStart = GetAllocationCount();
+}
+
+void FrameBenchmark::EndFrame() {
+  glEndQuery(GL_TIME_ELAPSED);
+  auto frameEnd = std::chrono::high_resolution_clock::now();
+  auto frameAllocationCount = GetAllocationCount() - m_frameAllocationStart;
+  if (m_frameIndex >= WARMUP_FRAME_COUNT) {
+    m_cpuTimes.push_back(
+      std::chrono::duration<double, std::milli>(frameEnd - m_frameStart).count());
+    m_allocationCount += frameAllocationCount;
+    m_maxFrameAllocationCount = std::max(m_maxFrameAllocationCount, frameAllocationCount);
+    const auto& glStats = GLState::GetFrameStats();
+    m_glCallsIssued += glStats.issued;
+    m_glCallsElided += glStats.elided;
+  }
+  m_frameIndex++;
+  CollectQueries(false);
+}
+
+/*
+geometry pass는 frame의 GL_TIME_ELAPSED query 안에 있으므로 glQueryCounter()로 시작 / 끝 시각을 기록
+  frame query와 같은 slot을 쓰고, frame 결과를 읽을 때 같이 읽음
+  (frame 시간에는 UI, SwapBuffers 등이 섞여 있어 draw 경로의 변화가 묻힐 수 있음)
+*/
+void FrameBenchmark::BeginGeometryPass() {
+  int slot = m_frameIndex % QUERY_COUNT;
+  glQueryCounter(m_geometryQueries[slot][0], GL_TIMESTAMP);
+}
+
+void FrameBenchmark::EndGeometryPass() {
+  int slot = m_frameIndex % QUERY_COUNT;
+  glQueryCounter(m_geometryQueries[slot][1], GL_TIMESTAMP);
+  m_geometryQueried[slot] = true;
+}
+
+void FrameBenchmark::Finish() {
+  CollectQueries(true);
+}
+
+void FrameBenchmark::CollectQueries(bool wait) {
+  for (int i = 0; i < QUERY_COUNT; i++) {
+    if (m_queryFrame[i] < 0)
+      continue;
+    if (!wait) {
+      int available = 0;
+      glGetQueryObjectiv(m_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+      if (!available)
+        continue;
+    }
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(m_queries[i], GL_QUERY_RESULT, &elapsed);
+    if (m_queryFrame[i] >= WARMUP_FRAME_COUNT)
+      m_gpuTimes.push_back((double)elapsed / 1000000.0);
+    // timestamp는 frame query가 끝나기 전에 기록되었으므로 이미 준비되어 있음
+    if (m_geometryQueried[i]) {
+      GLuint64 begin = 0;
+      GLuint64 end = 0;
+      glGetQueryObjectui64v(m_geometryQueries[i][0], GL_QUERY_RESULT, &begin);
+      glGetQueryObjectui64v(m_geometryQueries[i][1], GL_QUERY_RESULT, &end);
+      if (m_queryFrame[i] >= WARMUP_FRAME_COUNT)
+        m_geometryGpuTimes.push_back(end > begin ? (double)(end - begin) / 1000000.0 : 0.0);
+      m_geometryQueried[i] = false;
+    }
+    m_queryFrame[i] = -1;
+  }
+}
+
+// nearest-rank 방식의 백분위수
+static double Percentile(std::vector<double> values, double percent) {
+  if (values.empty())
+    return 0.0;
+  std::sort(values.begin(), values.end());
+  size_t rank = (size_t)std::ceil(percent / 100.0 * (double)values.size());
+  return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+}
+
+static std::string TimesToJson(const std::vector<double>& values) {
+  double sum = 0.0;
+  for (auto value : values)
+    sum += value;
+  return fmt::format(
+    "{{\"mean\": {:.4f}, \"p50\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f}}}",
+    values.empty() ? 0.0 : sum / (double)values.size(),
+    Percentile(values, 50.0), Percentile(values, 95.0), Percentile(values, 99.0));
+}
+
+double FrameBenchmark::PerFrame(uint64_t total) const {
+  return m_cpuTimes.empty() ? 0.0 : (double)total / (double)m_cpuTimes.size();
+}
+
+std::string FrameBenchmark::ToJson() const {
+  return fmt::format(
+    "{{\"frames\": {}, \"cpu_ms\": {}, \"gpu_ms\": {}, \"geometry_gpu_ms\": {}, "
+    "\"allocations\": {{\"total\": {}, \"max_per_frame\": {}}}, "
+    "\"gl_state_calls_per_frame\": {{\"issued\": {:.1f}, \"elided\": {:.1f}}}}}",
+    m_cpuTimes.size(), TimesToJson(m_cpuTimes), TimesToJson(m_gpuTimes),
+    TimesToJson(m_geometryGpuTimes),
+    m_allocationCount, m_maxFrameAllocationCount,
+    PerFrame(m_glCallsIssued), PerFrame(m_glCallsElided));
+}
+
+
+std::string RunUniformBenchmark(int iterations) {
+  auto program = Program::Create("./shader/lighting.vs", "./shader/lighting.fs");
+  if (!program)
+    return "{}";
+  program->Use();
+
+  glm::vec3 vec(1.0f);
+  glm::mat4 mat(1.0f);
+  const int callCount = 10;
+  auto measure = [&](auto&& setUniforms) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++)
+      setUniforms();
+    glFinish();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+      ((double)iterations * callCount);
+  };
+
+  double stringPath = measure([&]() {
+    program->SetUniform("viewPos", vec);
+    program->SetUniform("light.position", vec);
+    program->SetUniform("light.ambient", vec);
+    program->SetUniform("light.diffuse", vec);
+    program->SetUniform("light.specular", vec);
+    program->SetUniform("material.diffuse", 0);
+    program->SetUniform("material.specular", 1);
+    program->SetUniform("material.shininess", 32.0f);
+    program->SetUniform("transform", mat);
+    program->SetUniform("modelTransform", mat);
+  });
+  double hashPath = measure([&]() {
+    program->SetUniform("viewPos"_uniform, vec);
+    program->SetUniform("light.position"_uniform, vec);
+    program->SetUniform("light.ambient"_uniform, vec);
+    program->SetUniform("light.diffuse"_uniform, vec);
+    program->SetUniform("light.specular"_uniform, vec);
+    program->SetUniform("material.diffuse"_uniform, 0);
+    program->SetUniform("material.specular"_uniform, 1);
+    program->SetUniform("material.shininess"_uniform, 32.0f);
+    program->SetUniform("transform"_uniform, mat);
+    program->SetUniform("modelTransform"_uniform, mat);
+  });
+
+  return fmt::format(
+    "{{\"iterations\": {}, \"string_ns_per_call\": {:.2f}, "
+    "\"hash_ns_per_call\": {:.2f}, \"speedup\": {:.2f}}}",
+    iterations, stringPath, hashPath, hashPath > 0.0 ? stringPath / hashPath : 0.0);
+}
+
+std::string RunImportBenchmark(const std::string& filename) {
+  auto file = MappedFile::Open(filename);
+  if (!file)
+    return "{}";
+  double sizeMB = (double)file->GetSize() / (1024.0 * 1024.0);
+  file.reset();
+
+  int maxThreadCount = ModelImporter::GetDefaultThreadCount();
+  std::vector<int> threadCounts;
+  for (int threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+    threadCounts.push_back(threadCount);
+  threadCounts.push_back(maxThreadCount);
+
+  auto warmup = ModelImporter::Load(filename, maxThreadCount);
+  if (!warmup)
+    return "{}";
+  size_t vertexCount = warmup->GetVertexCount();
+  size_t indexCount = warmup->indices.size();
+
+  // cook 단계의 LOD 생성, index 최적화 비용과 효과도 같이 기록
+  auto lodStart = std::chrono::high_resolution_clock::now();
+  MeshSimplifier::GenerateLods(*warmup);
+  auto lodEnd = std::chrono::high_resolution_clock::now();
+  double lodMs = std::chrono::duration<double, std::milli>(lodEnd - lodStart).count();
+  std::string lods;
+  for (const auto& lod : warmup->lods) {
+    if (!lods.empty())
+      lods += ", ";
+    lods += fmt::format("{{\"indices\": {}, \"error\": {:.6f}}}", lod.indexCount, lod.error);
+  }
+
+  auto optimizeStart = std::chrono::high_resolution_clock::now();
+  auto optimizeStats = MeshOptimizer::Optimize(*warmup);
+  auto optimizeEnd = std::chrono::high_resolution_clock::now();
+  double optimizeMs =
+    std::chrono::duration<double, std::milli>(optimizeEnd - optimizeStart).count();
+  warmup.reset();
+
+  std::string results;
+  for (auto threadCount : threadCounts) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto mesh = ModelImporter::Load(filename, threadCount);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!mesh)
+      return "{}";
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    if (!results.empty())
+      results += ", ";
+    results += fmt::format("{{\"threads\": {}, \"ms\": {:.1f}, \"mb_per_s\": {:.1f}}}",
+      threadCount, ms, ms > 0.0 ? sizeMB * 1000.0 / ms : 0.0);
+  }
+  return fmt::format(
+    "{{\"file\": \"{}\", \"size_mb\": {:.1f}, \"vertices\": {}, \"indices\": {}, "
+    "\"results\": [{}], \"optimize\": {{\"ms\": {:.1f}, \"acmr_before\": {:.3f}, "
+    "\"acmr_after\": {:.3f}, \"atvr_before\": {:.3f}, \"atvr_after\": {:.3f}}}, "
+    "\"lod\": {{\"ms\": {:.1f}, \"levels\": [{}]}}}}",
+    filename, sizeMB, vertexCount, indexCount, results, optimizeMs,
+    optimizeStats.before.acmr, optimizeStats.after.acmr,
+    optimizeStats.before.atvr, optimizeStats.after.atvr, lodMs, lods);
+}
+
+std::string RunImageBenchmark(const std::string& directory) {
+  std::vector<std::string> filepaths;
+  uint64_t totalSize = 0;
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+    if (!entry.is_regular_file())
+      continue;
+    auto extension = entry.path().extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+      [](unsigned char c) { return (char)std::tolower(c); });
+    if (extension != ".jpg" && extension != ".jpeg" && extension != ".png")
+      continue;
+    filepaths.push_back(entry.path().string());
+    totalSize += entry.file_size();
+  }
+  if (error || filepaths.empty()) {
+    SPDLOG_ERROR("no images to load in: {}", directory);
+    return "{}";
+  }
+  std::sort(filepaths.begin(), filepaths.end());
+  double sizeMB = (double)totalSize / (1024.0 * 1024.0);
+
+  // page cache 채우기
+  Image::LoadMany(filepaths);
+
+  auto serialStart = std::chrono::high_resolution_clock::now();
+  size_t failedCount = 0;
+  for (const auto& filepath : filepaths)
+    failedCount += Image::Load(filepath) ? 0 : 1;
+  auto serialEnd = std::chrono::high_resolution_clock::now();
+  double serialMs = std::chrono::duration<double, std::milli>(serialEnd - serialStart).count();
+
+  int maxThreadCount = ModelImporter::GetDefaultThreadCount();
+  std::vector<int> threadCounts;
+  for (int threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+    threadCounts.push_back(threadCount);
+  threadCounts.push_back(maxThreadCount);
+
+  std::string results;
+  for (auto threadCount : threadCounts) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto images = Image::LoadMany(filepaths, threadCount);
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    if (!results.empty())
+      results += ", ";
+    results += fmt::format("{{\"threads\": {}, \"ms\": {:.1f}, \"speedup\": {:.2f}}}",
+      threadCount, ms, ms > 0.0 ? serialMs / ms : 0.0);
+  }
+  return fmt::format(
+    "{{\"directory\": \"{}\", \"files\": {}, \"failed\": {}, \"size_mb\": {:.1f}, "
+    "\"serial_ms\": {:.1f}, \"results\": [{}]}}",
+    directory, filepaths.size(), failedCount, sizeMB, serialMs, results);
+}
@@ -0,0 +1,72 @@
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include "common.h"
+#include <vector>
+#include <chrono>
+
+// --bench N 실행 시 프레임 별 CPU/GPU 시간을 기록하고 JSON으로 리포트
+CLASS_PTR(FrameBenchmark)
+class FrameBenchmark {
+public:
+  static FrameBenchmarkUPtr Create(int frameCount);
+  ~FrameBenchmark();
+
+  void BeginFrame();
+  void EndFrame();
+  // frame 안의 geometry pass (Context의 render queue 실행) 구간, 프레임마다 한 번
+  void BeginGeometryPass();
+  void EndGeometryPass();
+  // 아직 결과가 나오지 않은 GPU query들을 기다려서 모두 회수
+  void Finish();
+
+  bool IsDone() const { return m_frameIndex >= m_frameCount + WARMUP_FRAME_COUNT; }
+  int GetFrameCount() const { return m_frameCount; }
+  std::string ToJson() const;
+
+private:
+  FrameBenchmark() {}
+  bool Init(int frameCount);
+  void CollectQueries(bool wait);
+  double PerFrame(uint64_t total) const;
+
+  // 처음 몇 프레임은 셰이더 컴파일, 리소스 업로드 등으로 튀는 값이 나오므로 기록하지 않음
+  static constexpr int WARMUP_FRAME_COUNT = 3;
+  // GPU가 CPU보다 몇 프레임 늦게 끝나므로 query를 여러 개 돌려가며 사용
+  static constexpr int QUERY_COUNT = 4;
+  uint32_t m_queries[QUERY_COUNT] {};
+  int m_queryFrame[QUERY_COUNT] {};
+  // geometry pass 시작 / 끝의 GL_TIMESTAMP (frame 전체의 GL_TIME_ELAPSED 안이라 중첩 불가)
+  uint32_t m_geometryQueries[QUERY_COUNT][2] {};
+  bool m_geometryQueried[QUERY_COUNT] {};
+
+  int m_frameCount { 0 };
+  int m_frameIndex { 0 };
+  std::chrono::high_resolution_clock::time_point m_frameStart;
+  std::vector<double> m_cpuTimes;
+  std::vector<double> m_gpuTimes;
+  std::vector<double> m_geometryGpuTimes;
+
+  // 측정 구간(warmup 이후)의 operator new 호출 횟수
+  uint64_t m_frameAllocationStart { 0 };
+  uint64_t m_allocationCount { 0 };
+  uint64_t m_maxFrameAllocationCount { 0 };
+
+  // GLState가 실제로 GL에 전달한 / 생략한 state 변경 호출 수 (Context::Render 기준)
+  uint64_t m_glCallsIssued { 0 };
+  uint64_t m_glCallsElided { 0 };
+};
+
+// Program::SetUniform의 문자열 기반 경로와 hash table 기반 경로를 비교하는 micro benchmark
+// Context::Render가 한 프레임에 호출하는 것과 같은 uniform 세트를 iterations번 반복
+std::string RunUniformBenchmark(int iterations);
+
+// model 파일을 thread 수(1, 2, 4, ... hardware thread 수)를 바꿔가며 읽고 MB/s를 비교
+// 첫 로딩은 page cache를 채우는 용도로 버림
+std::string RunImportBenchmark(const std::string& filename);
+
+// directory 안의 jpg / png를 Image::Load()로 하나씩 읽은 시간과
+// Image::LoadMany()로 thread 수를 바꿔가며 읽은 시간을 비교 (speedup = 하나씩 / LoadMany)
+std::string RunImageBenchmark(const std::string& directory);
+
+#endif // __BENCHMARK_H__
@@ -1,4 +1,7 @@
 #include "buffer.h"
+#include "gl_state.h"
+#include "vertex_layout.h"
+#include <algorithm>
 
 BufferUPtr Buffer::CreateWithData(uint32_t bufferType, uint32_t usage,
   const void* data, size_t dataSize) {
@@ -9,14 +12,64 @@ BufferUPtr Buffer::CreateWithData(uint32_t bufferType, uint32_t usage,
   return std::move(buffer);
 }
 
+BufferUPtr Buffer::CreateStreaming(uint32_t bufferType, size_t frameSize,
+  int frameCount) {
+  
+  auto buffer = BufferUPtr(new Buffer());
+  if (!buffer->InitStreaming(bufferType, frameSize, frameCount))
+    return nullptr;
+  return std::move(buffer);
+}
+
 Buffer::~Buffer() {
+  for (auto& fence : m_fences) {
+    if (fence)
+      glDeleteSync(fence);
+  }
   if (m_buffer) {
+    // 삭제하면 mapping도 풀리므로 glUnmapBuffer()는 따로 부르지 않는다
     glDeleteBuffers(1, &m_buffer);
+    GLState::ForgetBuffer(m_buffer);
+    VertexLayoutCache::ForgetBuffer(m_buffer);
   }
 }
 
 void Buffer::Bind() const {
-  glBindBuffer(m_bufferType, m_buffer);
+  GLState::BindBuffer(m_bufferType, m_buffer);
+}
+
+void Buffer::BindBase(uint32_t index) const {
+  GLState::BindBufferBase(m_bufferType, index, m_buffer);
+}
+
+/*
+glBufferData(nullptr): 이전 저장 공간을 버리고(orphaning) 새 공간을 할당
+  -> GPU가 아직 이전 프레임 데이터를 읽고 있어도 기다리지 않고 쓸 수 있다
+glBufferSubData(): 버퍼의 일부(여기서는 처음부터 dataSize만큼)에 데이터를 복사
+DSA: 크기가 고정된 storage라 glInvalidateBufferData()로 이전 내용을 버린다고 알려서 같은 효과
+*/
+void Buffer::UpdateData(const void* data, size_t dataSize) const {
+  if (GLState::HasDirectStateAccess()) {
+    glInvalidateBufferData(m_buffer);
+    glNamedBufferSubData(m_buffer, 0, std::min(dataSize, m_dataSize), data);
+    return;
+  }
+  Bind();
+  glBufferData(m_bufferType, m_dataSize, nullptr, m_usage);
+  glBufferSubData(m_bufferType, 0, std::min(dataSize, m_dataSize), data);
+}
+
+void Buffer::UpdateSubData(size_t offset, const void* data, size_t dataSize) const {
+  if (offset + dataSize > m_dataSize) {
+    SPDLOG_ERROR("buffer sub data out of range: {} + {} > {}", offset, dataSize, m_dataSize);
+    return;
+  }
+  if (GLState::HasDirectStateAccess()) {
+    glNamedBufferSubData(m_buffer, offset, dataSize, data);
+    return;
+  }
+  Bind();
+  glBufferSubData(m_bufferType, offset, dataSize, data);
 }
 
 bool Buffer::Init(uint32_t bufferType, uint32_t usage,
@@ -24,8 +77,125 @@ bool Buffer::Init(uint32_t bufferType, uint32_t usage,
   
   m_bufferType = bufferType;
   m_usage = usage;
+  m_dataSize = dataSize;
+  // DSA: 만들 때 어디에도 바인딩하지 않음 (VAO의 index buffer 등 현재 바인딩이 그대로 유지)
+  // 크기는 고정, UpdateData() / UpdateSubData()를 위해 DYNAMIC_STORAGE
+  if (GLState::HasDirectStateAccess()) {
+    glCreateBuffers(1, &m_buffer);
+    glNamedBufferStorage(m_buffer, dataSize, data, GL_DYNAMIC_STORAGE_BIT);
+    return true;
+  }
   glGenBuffers(1, &m_buffer);
   Bind();
   glBufferData(m_bufferType, dataSize, data, usage);
   return true;
+}
+
+/*
+streaming buffer
+  - GL 4.4 / ARB_buffer_storage: glBufferStorage()로 크기가 고정된 저장 공간을 만들고
+    PERSISTENT | COHERENT로 한 번만 map해서 계속 사용 (map / unmap 비용, 암묵적 동기화 없음)
+    (DSA가 있으면 glNamedBufferStorage() / glMapNamedBufferRange()로 바인딩 없이)
+  - 그 외: glBufferData()로 만든 뒤 할당마다 glMapBufferRange(UNSYNCHRONIZED)로 map
+    -> driver가 GPU 사용 여부를 확인하지 않으므로 fence로 직접 보호해야 한다
+  두 경우 모두 frameCount개 구역을 돌려 쓰고, 구역마다 glFenceSync()로 GPU 사용이 끝났는지 확인
+*/
+bool Buffer::InitStreaming(uint32_t bufferType, size_t frameSize, int frameCount) {
+  if (frameSize == 0 || frameCount < 1 || frameCount > MAX_STREAM_FRAME_COUNT) {
+    SPDLOG_ERROR("invalid streaming buffer size: {} x {}", frameSize, frameCount);
+    return false;
+  }
+  m_bufferType = bufferType;
+  m_usage = GL_STREAM_DRAW;
+  m_frameSize = frameSize;
+  m_frameCount = frameCount;
+  m_dataSize = frameSize * frameCount;
+  // 첫 BeginFrame()에서 0번 구역부터 사용
+  m_frame = frameCount - 1;
+
+  GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  // DSA가 있으면(GL 4.5) buffer storage도 있으므로 항상 persistent mapping
+  if (GLState::HasDirectStateAccess()) {
+    glCreateBuffers(1, &m_buffer);
+    glNamedBufferStorage(m_buffer, m_dataSize, nullptr, flags);
+    m_mappedData = (uint8_t*)glMapNamedBufferRange(m_buffer, 0, m_dataSize, flags);
+    if (!m_mappedData) {
+      SPDLOG_ERROR("failed to map streaming buffer");
+      return false;
+    }
+    return true;
+  }
+
+  glGenBuffers(1, &m_buffer);
+  Bind();
+  if (GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage) {
+    glBufferStorage(m_bufferType, m_dataSize, nullptr, flags);
+    m_mappedData = (uint8_t*)glMapBufferRange(m_bufferType, 0, m_dataSize, flags);
+    if (!m_mappedData) {
+      SPDLOG_ERROR("failed to map streaming buffer");
+      return false;
+    }
+  }
+  else {
+    glBufferData(m_bufferType, m_dataSize, nullptr, m_usage);
+  }
+  return true;
+}
+
+/*
+glClientWaitSync(): fence 이전의 GL 명령이 끝날 때까지 최대 timeout(ns)만큼 대기
+  - GL_SYNC_FLUSH_COMMANDS_BIT: fence가 아직 driver에 전달되지 않았다면 flush
+  - 구역이 frameCount개이므로 보통은 이미 signal된 상태 (GL_ALREADY_SIGNALED)
+*/
+void Buffer::BeginFrame() {
+  m_frame = (m_frame + 1) % m_frameCount;
+  m_frameOffset = 0;
+  auto& fence = m_fences[m_frame];
+  if (!fence)
+    return;
+  auto result = glClientWaitSync(fence, 0, 0);
+  if (result == GL_TIMEOUT_EXPIRED) {
+    m_stallCount++;
+    do {
+      result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    } while (result == GL_TIMEOUT_EXPIRED);
+  }
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+
+Buffer::StreamAllocation Buffer::Allocate(size_t size, size_t alignment) {
+  StreamAllocation allocation;
+  size_t offset = (m_frameOffset + alignment - 1) / alignment * alignment;
+  if (offset + size > m_frameSize)
+    return allocation;
+  m_frameOffset = offset + size;
+  allocation.offset = m_frameSize * m_frame + offset;
+
+  if (m_mappedData) {
+    allocation.data = m_mappedData + allocation.offset;
+  }
+  else {
+    Bind();
+    allocation.data = glMapBufferRange(m_bufferType, allocation.offset, size,
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    m_mappedRange = allocation.data != nullptr;
+  }
+  return allocation;
+}
+
+// COHERENT mapping은 쓰는 즉시 GPU에서 보이므로 unmap / flush가 필요 없다
+void Buffer::Commit() {
+  if (m_mappedRange) {
+    Bind();
+    glUnmapBuffer(m_bufferType);
+    m_mappedRange = false;
+  }
+}
+
+void Buffer::EndFrame() {
+  auto& fence = m_fences[m_frame];
+  if (fence)
+    glDeleteSync(fence);
+  fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 }
\ No newline at end of file
@@ -8,18 +8,63 @@ class Buffer {
 public:
   static BufferUPtr CreateWithData(uint32_t bufferType, uint32_t usage,
     const void* data, size_t dataSize);
+  // 매 프레임 CPU가 새로 채우는 데이터용 ring buffer
+  // frameSize: 한 프레임에 쓸 수 있는 최대 크기, frameCount개의 구역을 돌려가며 사용
+  static BufferUPtr CreateStreaming(uint32_t bufferType, size_t frameSize,
+    int frameCount = 3);
+
+  // streaming buffer에서 받은 영역: data에 쓰고, GL에는 offset을 넘긴다
+  struct StreamAllocation {
+    void* data { nullptr };
+    size_t offset { 0 };
+  };
   
   ~Buffer();
   uint32_t Get() const { return m_buffer; }
+  size_t GetSize() const { return m_dataSize; }
   void Bind() const;
+  // uniform buffer 등 indexed binding point에 연결
+  void BindBase(uint32_t index) const;
+  // 매 프레임 바뀌는 데이터 업로드 (기존 저장 공간은 버리고 새로 할당받음)
+  void UpdateData(const void* data, size_t dataSize) const;
+  // 버퍼의 [offset, offset + dataSize) 부분만 덮어씀 (나머지 내용은 유지)
+  void UpdateSubData(size_t offset, const void* data, size_t dataSize) const;
+
+  // streaming mode
+  // BeginFrame(): 다음 구역으로 넘어감 (GPU가 아직 그 구역을 읽고 있으면 fence를 기다림)
+  // Allocate(): 이번 프레임 구역에서 size만큼 할당, 공간이 부족하면 data가 nullptr
+  // Commit(): 할당받은 영역에 다 쓴 뒤 draw 전에 호출 (persistent mapping이면 할 일 없음)
+  // EndFrame(): 이번 프레임 구역을 사용한 GL 명령 뒤에 fence 추가
+  void BeginFrame();
+  StreamAllocation Allocate(size_t size, size_t alignment = 16);
+  void Commit();
+  void EndFrame();
+  bool IsPersistentMapped() const { return m_mappedData != nullptr; }
+  size_t GetFrameSize() const { return m_frameSize; }
+  // fence가 아직 끝나지 않아 CPU가 기다린 횟수
+  uint64_t GetStallCount() const { return m_stallCount; }
+
 private:
   Buffer() {}
   bool Init(uint32_t bufferType, uint32_t usage, 
     const void* data, size_t dataSize);
+  bool InitStreaming(uint32_t bufferType, size_t frameSize, int frameCount);
 
   uint32_t m_buffer { 0 };
   uint32_t m_bufferType { 0 };
   uint32_t m_usage { 0 };
+  size_t m_dataSize { 0 };
+
+  // streaming mode
+  static constexpr int MAX_STREAM_FRAME_COUNT = 4;
+  uint8_t* m_mappedData { nullptr };
+  bool m_mappedRange { false };
+  size_t m_frameSize { 0 };
+  int m_frameCount { 0 };
+  int m_frame { 0 };
+  size_t m_frameOffset { 0 };
+  GLsync m_fences[MAX_STREAM_FRAME_COUNT] {};
+  uint64_t m_stallCount { 0 };
 };
 
 
@@ -0,0 +1,187 @@
+#include "buffer_arena.h"
+#include "gl_state.h"
+#include <algorithm>
+
+BufferArenaUPtr BufferArena::Create(const VertexFormat& vertexFormat,
+  uint32_t vertexCapacity, uint32_t indexCapacity) {
+  auto arena = BufferArenaUPtr(new BufferArena());
+  if (!arena->Init(vertexFormat, vertexCapacity, indexCapacity))
+    return nullptr;
+  return std::move(arena);
+}
+
+bool BufferArena::Init(const VertexFormat& vertexFormat, uint32_t vertexCapacity,
+  uint32_t indexCapacity) {
+  if (vertexFormat.stride == 0 || vertexCapacity == 0 || indexCapacity == 0) {
+    SPDLOG_ERROR("invalid buffer arena size: stride {}, {} vertices, {} indices",
+      vertexFormat.stride, vertexCapacity, indexCapacity);
+    return false;
+  }
+  m_vertexFormat = vertexFormat;
+  m_vertexStride = vertexFormat.stride;
+  m_vertexBuffer = CreateVertexBuffer(vertexCapacity);
+  m_indexBuffer = CreateIndexBuffer(indexCapacity);
+  m_vertexAllocator = std::make_unique<OffsetAllocator>(vertexCapacity);
+  m_indexAllocator = std::make_unique<OffsetAllocator>(indexCapacity);
+  UpdateVertexLayout();
+  return true;
+}
+
+BufferUPtr BufferArena::CreateVertexBuffer(uint32_t vertexCapacity) const {
+  return Buffer::CreateWithData(GL_ARRAY_BUFFER, GL_STATIC_DRAW,
+    nullptr, (size_t)m_vertexStride * vertexCapacity);
+}
+
+// GL_ELEMENT_ARRAY_BUFFER 바인딩은 지금 바인딩된 VAO의 상태를 바꾸므로
+// 생성 / 업로드는 VAO와 관계없는 GL_COPY_WRITE_BUFFER로 하고 VAO 연결은 cache에 맡긴다
+BufferUPtr BufferArena::CreateIndexBuffer(uint32_t indexCapacity) const {
+  return Buffer::CreateWithData(GL_COPY_WRITE_BUFFER, GL_STATIC_DRAW,
+    nullptr, sizeof(uint32_t) * indexCapacity);
+}
+
+void BufferArena::UpdateVertexLayout() {
+  m_vertexLayout = VertexLayoutCache::Get({ { &m_vertexFormat, m_vertexBuffer->Get() } },
+    m_indexBuffer->Get());
+}
+
+uint32_t BufferArena::AddMesh(const void* vertices, uint32_t vertexCount,
+  const uint32_t* indices, uint32_t indexCount) {
+  if (vertexCount == 0 || indexCount == 0)
+    return INVALID_MESH;
+
+  Mesh mesh;
+  mesh.vertexCount = vertexCount;
+  mesh.indexCount = indexCount;
+  mesh.vertex = m_vertexAllocator->Allocate(vertexCount);
+  mesh.index = m_indexAllocator->Allocate(indexCount);
+  if (!mesh.vertex.IsValid() || !mesh.index.IsValid()) {
+    m_vertexAllocator->Free(mesh.vertex);
+    m_indexAllocator->Free(mesh.index);
+    // 공간이 부족하면 두 배 이상으로 키워서 다시 시도
+    Relocate(
+      std::max(m_vertexAllocator->GetSize() * 2, m_vertexAllocator->GetSize() + vertexCount),
+      std::max(m_indexAllocator->GetSize() * 2, m_indexAllocator->GetSize() + indexCount));
+    mesh.vertex = m_vertexAllocator->Allocate(vertexCount);
+    mesh.index = m_indexAllocator->Allocate(indexCount);
+    if (!mesh.vertex.IsValid() || !mesh.index.IsValid()) {
+      SPDLOG_ERROR("failed to allocate mesh in buffer arena: {} vertices, {} indices",
+        vertexCount, indexCount);
+      m_vertexAllocator->Free(mesh.vertex);
+      m_indexAllocator->Free(mesh.index);
+      return INVALID_MESH;
+    }
+  }
+  mesh.used = true;
+
+  m_vertexBuffer->UpdateSubData((size_t)m_vertexStride * mesh.vertex.offset,
+    vertices, (size_t)m_vertexStride * vertexCount);
+  m_indexBuffer->UpdateSubData(sizeof(uint32_t) * mesh.index.offset,
+    indices, sizeof(uint32_t) * indexCount);
+
+  uint32_t meshId;
+  if (!m_freeMeshIds.empty()) {
+    meshId = m_freeMeshIds.back();
+    m_freeMeshIds.pop_back();
+    m_meshes[meshId] = mesh;
+  }
+  else {
+    meshId = (uint32_t)m_meshes.size();
+    m_meshes.push_back(mesh);
+  }
+  return meshId;
+}
+
+void BufferArena::RemoveMesh(uint32_t meshId) {
+  if (meshId >= m_meshes.size() || !m_meshes[meshId].used)
+    return;
+  auto& mesh = m_meshes[meshId];
+  m_vertexAllocator->Free(mesh.vertex);
+  m_indexAllocator->Free(mesh.index);
+  mesh = Mesh();
+  m_freeMeshIds.push_back(meshId);
+}
+
+BufferArena::MeshRange BufferArena::GetMeshRange(uint32_t meshId) const {
+  MeshRange range;
+  if (meshId >= m_meshes.size() || !m_meshes[meshId].used)
+    return range;
+  const auto& mesh = m_meshes[meshId];
+  range.baseVertex = (int32_t)mesh.vertex.offset;
+  range.firstIndex = mesh.index.offset;
+  range.indexCount = mesh.indexCount;
+  return range;
+}
+
+void BufferArena::Compact() {
+  Relocate(m_vertexAllocator->GetSize(), m_indexAllocator->GetSize());
+  m_compactionCount++;
+}
+
+/*
+glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size):
+  GPU 안에서 buffer 사이로 데이터를 복사 (CPU로 읽어오지 않음)
+  - GL_COPY_READ_BUFFER / GL_COPY_WRITE_BUFFER: 복사 전용 binding point
+  - DSA: glCopyNamedBufferSubData()로 바인딩 없이 buffer 이름으로 복사
+기존 offset 순서대로 새 buffer의 앞에서부터 다시 할당하므로 빈 틈이 사라진다
+*/
+static void CopyBufferData(const Buffer* source, const Buffer* destination,
+  size_t sourceOffset, size_t destinationOffset, size_t size) {
+  if (GLState::HasDirectStateAccess()) {
+    glCopyNamedBufferSubData(source->Get(), destination->Get(),
+      sourceOffset, destinationOffset, size);
+    return;
+  }
+  GLState::BindBuffer(GL_COPY_READ_BUFFER, source->Get());
+  GLState::BindBuffer(GL_COPY_WRITE_BUFFER, destination->Get());
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+    sourceOffset, destinationOffset, size);
+}
+
+void BufferArena::Relocate(uint32_t vertexCapacity, uint32_t indexCapacity) {
+  std::vector<uint32_t> meshIds;
+  meshIds.reserve(m_meshes.size());
+  for (uint32_t i = 0; i < (uint32_t)m_meshes.size(); i++) {
+    if (m_meshes[i].used)
+      meshIds.push_back(i);
+  }
+  std::sort(meshIds.begin(), meshIds.end(), [this](uint32_t a, uint32_t b) {
+    return m_meshes[a].vertex.offset < m_meshes[b].vertex.offset;
+  });
+
+  auto vertexBuffer = CreateVertexBuffer(vertexCapacity);
+  auto indexBuffer = CreateIndexBuffer(indexCapacity);
+  auto vertexAllocator = std::make_unique<OffsetAllocator>(vertexCapacity);
+  auto indexAllocator = std::make_unique<OffsetAllocator>(indexCapacity);
+
+  for (auto meshId : meshIds) {
+    auto& mesh = m_meshes[meshId];
+    auto vertex = vertexAllocator->Allocate(mesh.vertexCount);
+    auto index = indexAllocator->Allocate(mesh.indexCount);
+
+    CopyBufferData(m_vertexBuffer.get(), vertexBuffer.get(),
+      (size_t)m_vertexStride * mesh.vertex.offset, (size_t)m_vertexStride * vertex.offset,
+      (size_t)m_vertexStride * mesh.vertexCount);
+    CopyBufferData(m_indexBuffer.get(), indexBuffer.get(),
+      sizeof(uint32_t) * mesh.index.offset, sizeof(uint32_t) * index.offset,
+      sizeof(uint32_t) * mesh.indexCount);
+
+    mesh.vertex = vertex;
+    mesh.index = index;
+  }
+
+  m_vertexBuffer = std::move(vertexBuffer);
+  m_indexBuffer = std::move(indexBuffer);
+  m_vertexAllocator = std::move(vertexAllocator);
+  m_indexAllocator = std::move(indexAllocator);
+  // 이전 buffer가 삭제되면서 cache에서 이전 VAO도 지워짐
+  UpdateVertexLayout();
+}
+
+BufferArena::Stats BufferArena::GetStats() const {
+  Stats stats;
+  stats.vertex = m_vertexAllocator->GetStats();
+  stats.index = m_indexAllocator->GetStats();
+  stats.meshCount = (uint32_t)(m_meshes.size() - m_freeMeshIds.size());
+  stats.compactionCount = m_compactionCount;
+  return stats;
+}
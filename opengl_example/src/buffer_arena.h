@@ -0,0 +1,86 @@
+#ifndef __BUFFER_ARENA_H__
+#define __BUFFER_ARENA_H__
+
+#include "common.h"
+#include "buffer.h"
+#include "vertex_layout.h"
+#include "offset_allocator.h"
+#include <vector>
+
+/*
+** Buffer arena
+  여러 mesh의 정점 / 인덱스를 큰 vertex buffer, index buffer 하나씩에 모아서 저장
+  - 영역은 OffsetAllocator(TLSF)로 할당 (정점 / 인덱스 개수 단위)
+  - 모든 mesh가 VAO 하나(VertexLayoutCache)를 공유: mesh를 바꿔 그릴 때 VAO / buffer를 다시 바인딩하지 않고
+    glDrawElementsBaseVertex()의 base vertex, 인덱스 offset만 바꾼다
+  - 공간이 부족하면 두 배 크기로 옮기고, Compact()로 빈 틈을 없앨 수 있다
+*/
+CLASS_PTR(BufferArena)
+class BufferArena {
+public:
+  static constexpr uint32_t INVALID_MESH = 0xFFFFFFFF;
+
+  struct MeshRange {
+    int32_t baseVertex { 0 };
+    uint32_t firstIndex { 0 };
+    uint32_t indexCount { 0 };
+  };
+
+  struct Stats {
+    OffsetAllocator::Stats vertex;
+    OffsetAllocator::Stats index;
+    uint32_t meshCount { 0 };
+    uint32_t compactionCount { 0 };
+  };
+
+  // 모든 mesh가 vertexFormat 형식의 정점을 가짐, capacity는 정점 / 인덱스 개수
+  static BufferArenaUPtr Create(const VertexFormat& vertexFormat,
+    uint32_t vertexCapacity, uint32_t indexCapacity);
+
+  // 인덱스는 mesh 자신의 정점 기준 (0부터), 실패하면 INVALID_MESH
+  uint32_t AddMesh(const void* vertices, uint32_t vertexCount,
+    const uint32_t* indices, uint32_t indexCount);
+  void RemoveMesh(uint32_t meshId);
+  MeshRange GetMeshRange(uint32_t meshId) const;
+
+  // 살아 있는 mesh들을 앞에서부터 빈틈없이 다시 배치 (mesh id는 그대로 유지)
+  void Compact();
+  Stats GetStats() const;
+  // VertexLayoutCache가 소유한 VAO (buffer를 옮기면 바뀜)
+  const VertexLayout* GetVertexLayout() const { return m_vertexLayout; }
+  const VertexFormat& GetVertexFormat() const { return m_vertexFormat; }
+  // 다른 buffer(instance data 등)를 같이 연결한 VAO를 cache에서 얻을 때 사용
+  const Buffer* GetVertexBuffer() const { return m_vertexBuffer.get(); }
+  const Buffer* GetIndexBuffer() const { return m_indexBuffer.get(); }
+
+private:
+  BufferArena() {}
+  bool Init(const VertexFormat& vertexFormat, uint32_t vertexCapacity,
+    uint32_t indexCapacity);
+  BufferUPtr CreateVertexBuffer(uint32_t vertexCapacity) const;
+  BufferUPtr CreateIndexBuffer(uint32_t indexCapacity) const;
+  // 새 크기의 buffer를 만들고 살아 있는 mesh를 glCopyBufferSubData()로 옮김
+  void Relocate(uint32_t vertexCapacity, uint32_t indexCapacity);
+  void UpdateVertexLayout();
+
+  struct Mesh {
+    OffsetAllocator::Allocation vertex;
+    OffsetAllocator::Allocation index;
+    uint32_t vertexCount { 0 };
+    uint32_t indexCount { 0 };
+    bool used { false };
+  };
+
+  VertexFormat m_vertexFormat;
+  uint32_t m_vertexStride { 0 };
+  const VertexLayout* m_vertexLayout { nullptr };
+  BufferUPtr m_vertexBuffer;
+  BufferUPtr m_indexBuffer;
+  std::unique_ptr<OffsetAllocator> m_vertexAllocator;
+  std::unique_ptr<OffsetAllocator> m_indexAllocator;
+  std::vector<Mesh> m_meshes;
+  std::vector<uint32_t> m_freeMeshIds;
+  uint32_t m_compactionCount { 0 };
+};
+
+#endif // __BUFFER_ARENA_H__
@@ -1,6 +1,17 @@
 #include "context.h"
 #include "image.h"
+#include "gl_state.h"
+#include "mesh_file.h"
 #include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+// CMake 밖에서 build하면 작업 디렉토리 기준 경로에서 읽음
+#ifndef CUBE_MESH_PATH
+#define CUBE_MESH_PATH "./model/cube.mesh"
+#endif
 
 ContextUPtr Context::Create() {
   auto context = ContextUPtr(new Context());
@@ -9,6 +20,11 @@ ContextUPtr Context::Create() {
   return std::move(context);
 }
 
+// cache의 VAO는 GL context가 살아 있을 때 지워야 한다
+Context::~Context() {
+  VertexLayoutCache::Clear();
+}
+
 // glfwGetKey() -> window에서 어떤 키가 눌렸는지 판단하는 함수
 void Context::ProcessInput(GLFWwindow* window) {
   if (!m_cameraControl)
@@ -33,6 +49,106 @@ void Context::ProcessInput(GLFWwindow* window) {
     m_cameraPos -= cameraSpeed * cameraUp;
 }
 
+// 처음 10개는 고정 위치, 그 이후의 큐브는 카메라 앞쪽 격자에 배치
+static glm::vec3 GetCubePosition(int index) {
+  static const glm::vec3 cubePositions[] = {
+    glm::vec3( 0.0f, 0.0f, 0.0f),
+    glm::vec3( 2.0f, 5.0f, -15.0f),
+    glm::vec3(-1.5f, -2.2f, -2.5f),
+    glm::vec3(-3.8f, -2.0f, -12.3f),
+    glm::vec3( 2.4f, -0.4f, -3.5f),
+    glm::vec3(-1.7f, 3.0f, -7.5f),
+    glm::vec3( 1.3f, -2.0f, -2.5f),
+    glm::vec3( 1.5f, 2.0f, -2.5f),
+    glm::vec3( 1.5f, 0.2f, -1.5f),
+    glm::vec3(-1.3f, 1.0f, -1.5f),
+  };
+  const int baseCount = (int)(sizeof(cubePositions) / sizeof(cubePositions[0]));
+  if (index < baseCount)
+    return cubePositions[index];
+
+  const int gridSize = 50;
+  int gridIndex = index - baseCount;
+  return glm::vec3(
+    (float)(gridIndex % gridSize - gridSize / 2) * 2.0f,
+    (float)((gridIndex / gridSize) % gridSize - gridSize / 2) * 2.0f,
+    -20.0f - (float)(gridIndex / (gridSize * gridSize)) * 2.0f);
+}
+
+// 개수가 바뀔 때만 scene에 큐브를 추가/제거 (매 프레임 다시 만들지 않음)
+void Context::SetCubeCount(int count) {
+  m_cubeCount = std::clamp(count, 1, MAX_CUBE_COUNT);
+  while ((int)m_cubeIds.size() > m_cubeCount) {
+    m_scene->RemoveObject(m_cubeIds.back());
+    m_cubeIds.pop_back();
+  }
+  while ((int)m_cubeIds.size() < m_cubeCount) {
+    int index = (int)m_cubeIds.size();
+    // 한 변이 1인 큐브를 감싸는 sphere 반지름 = sqrt(3) / 2
+    m_cubeIds.push_back(m_scene->AddObject(GetCubePosition(index),
+      glm::vec3(1.0f, 0.5f, 0.0f), 20.0f * (float)index, 120.0f,
+      glm::vec3(1.0f), 0.8660254f));
+  }
+  m_visibleIndices.resize(m_cubeCount);
+  ReserveInstanceBuffer(GetInstanceReserveCount(m_cubeCount));
+  m_allIndices.resize(m_cubeCount);
+  for (size_t i = 0; i < m_allIndices.size(); i++)
+    m_allIndices[i] = (uint32_t)i;
+}
+
+// object instanceCount개를 그릴 때 필요한 instance 수
+// batch(LOD)마다 할당 정렬로 instance 하나 미만이 비므로 LOD 수만큼 여유를 둠
+size_t Context::GetInstanceReserveCount(size_t instanceCount) const {
+  return instanceCount + std::max<size_t>(m_cubeLods.size(), 1);
+}
+
+// instance buffer의 한 프레임 구역이 부족하면 더 큰 streaming buffer로 교체
+void Context::ReserveInstanceBuffer(size_t instanceCount) {
+  if (instanceCount <= m_instanceCapacity)
+    return;
+  m_instanceCapacity = std::max(instanceCount, m_instanceCapacity * 2);
+  if (m_instanceBuffer)
+    m_retiredBuffers.push_back(std::move(m_instanceBuffer));
+  m_instanceBuffer = Buffer::CreateStreaming(GL_ARRAY_BUFFER,
+    sizeof(CubeInstance) * m_instanceCapacity);
+  if (m_multiDrawIndirectSupported) {
+    if (m_indirectBuffer)
+      m_retiredBuffers.push_back(std::move(m_indirectBuffer));
+    m_indirectBuffer = Buffer::CreateStreaming(GL_DRAW_INDIRECT_BUFFER,
+      sizeof(DrawElementsIndirectCommand) * m_instanceCapacity);
+  }
+  UpdateCubeVertexLayout();
+}
+
+// mesh arena나 instance buffer가 바뀌면 cache에서 새 조합의 VAO를 얻음 (같으면 기존 VAO)
+void Context::UpdateCubeVertexLayout() {
+  auto vertexBuffer = m_meshArena->GetVertexBuffer()->Get();
+  auto indexBuffer = m_meshArena->GetIndexBuffer()->Get();
+  if (m_baseInstance) {
+    m_cubeVertexLayout = VertexLayoutCache::Get({
+      { &m_meshArena->GetVertexFormat(), vertexBuffer },
+      { &CUBE_INSTANCE_FORMAT, m_instanceBuffer->Get(), 0, 1 },
+    }, indexBuffer);
+    return;
+  }
+  // base instance가 없으면 batch마다 instance binding의 offset을 바꾸므로 (SetInstanceAttribs)
+  // cache의 VAO(key는 offset 0)를 건드리지 않도록 Context가 소유한 VAO를 따로 사용
+  // instance binding을 batch마다 다시 설정하는 경로라 매 프레임 전체를 다시 연결해도 비용이 작음
+  if (!m_instanceOffsetLayout)
+    m_instanceOffsetLayout = VertexLayout::Create();
+  m_instanceOffsetLayout->SetVertexBuffer(0, vertexBuffer, m_meshArena->GetVertexFormat());
+  m_instanceOffsetLayout->SetVertexBuffer(1, m_instanceBuffer->Get(), CUBE_INSTANCE_FORMAT, 0, 1);
+  m_instanceOffsetLayout->SetIndexBuffer(indexBuffer);
+  m_cubeVertexLayout = m_instanceOffsetLayout.get();
+}
+
+// base instance가 없을 때: 이번 batch의 instance data 위치(offset)로 instance attribute를 다시 연결
+// (m_cubeVertexLayout은 이 경우 cache가 아닌 Context 소유의 VAO)
+void Context::SetInstanceAttribs(size_t offset) {
+  m_instanceOffsetLayout->SetVertexBuffer(1, m_instanceBuffer->Get(), CUBE_INSTANCE_FORMAT,
+    offset, 1);
+}
+
 void Context::Reshape(int width, int height) {
   m_width = width;
   m_height = height;
@@ -73,47 +189,6 @@ void Context::MouseButton(int button, int action, double x, double y) {
 }
 
 bool Context::Init() {
-  float vertices[] = {
-    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f, 0.0f, 0.0f,
-    0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f, 1.0f, 0.0f,
-    0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f, 1.0f, 1.0f,
-    -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f, 0.0f, 1.0f,
-
-    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f, 0.0f, 0.0f,
-    0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f, 1.0f, 0.0f,
-    0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f, 1.0f, 1.0f,
-    -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f, 0.0f, 1.0f,
-
-    -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f, 1.0f, 0.0f,
-    -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f, 1.0f, 1.0f,
-    -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f, 0.0f, 1.0f,
-    -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f, 0.0f, 0.0f,
-
-    0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f, 1.0f, 0.0f,
-    0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f, 1.0f, 1.0f,
-    0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f, 0.0f, 1.0f,
-    0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f, 0.0f, 0.0f,
-
-    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f, 0.0f, 1.0f,
-    0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f, 1.0f, 1.0f,
-    0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f,
-    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f, 0.0f, 0.0f,
-
-    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f, 0.0f, 1.0f,
-    0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f, 1.0f, 1.0f,
-    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f, 1.0f, 0.0f,
-    -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f, 0.0f, 0.0f,
-  };
-
-  uint32_t indices[] = {
-    0,  2,  1,  2,  0,  3,
-    4,  5,  6,  6,  7,  4,
-    8,  9, 10, 10, 11,  8,
-    12, 14, 13, 14, 12, 15,
-    16, 17, 18, 18, 19, 16,
-    20, 22, 21, 22, 20, 23,
-  };
-
   /*
   ** Vertex Buffer Object (VBO)
 
@@ -170,15 +245,30 @@ bool Context::Init() {
 
   */
 
-  m_vertexLayout = VertexLayout::Create();
-  //vao 생성 후에 buffer를 만들어야 연결 가능
-  m_vertexBuffer = Buffer::CreateWithData(GL_ARRAY_BUFFER, GL_STATIC_DRAW, vertices, sizeof(float) * 8 * 6 * 4);
-
-  m_vertexLayout->SetAttrib(0, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, 0);
-  m_vertexLayout->SetAttrib(1, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, sizeof(float) * 3);
-  m_vertexLayout->SetAttrib(2, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 8, sizeof(float) * 6);
+  // 큐브 mesh는 mesh_converter로 만든 .mesh 파일을 mmap 해서 복사 없이 바로 업로드
+  // (CMake build에서는 build 디렉토리에 생성된 파일의 경로가 CUBE_MESH_PATH로 넘어옴)
+  auto cubeFile = MeshFile::Load(CUBE_MESH_PATH);
+  if (!cubeFile)
+    return false;
 
-  m_indexBuffer = Buffer::CreateWithData(GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW, indices, sizeof(uint32_t) * 36);
+  // 정점 24개짜리 큐브 수천 개를 넣을 수 있는 크기로 시작 (부족하면 arena가 알아서 키움)
+  auto cubeFormat = MakeVertexFormat(cubeFile->GetVertexStride(), cubeFile->GetAttribs(),
+    cubeFile->GetAttribCount());
+  m_meshArena = BufferArena::Create(cubeFormat, 1 << 16, 1 << 17);
+  if (!m_meshArena)
+    return false;
+  for (uint32_t i = 0; i < cubeFormat.attribCount; i++) {
+    // normal이 2성분이면 octahedral encoding
+    if (cubeFormat.attribs[i].attribIndex == 1)
+      m_octahedralNormal = cubeFormat.attribs[i].count == 2;
+  }
+  m_cubePositionScale = cubeFile->GetPositionScale();
+  m_cubePositionOffset = cubeFile->GetPositionOffset();
+  m_cubeLods.assign(cubeFile->GetLods(), cubeFile->GetLods() + cubeFile->GetLodCount());
+  m_cubeMesh = m_meshArena->AddMesh(cubeFile->GetVertexData(), cubeFile->GetVertexCount(),
+    cubeFile->GetIndexData(), cubeFile->GetIndexCount());
+  if (m_cubeMesh == BufferArena::INVALID_MESH)
+    return false;
 
   // OpenGL 함수 로딩 후에야 shader 불러오기 위한 함수들 사용 가능
   m_simpleProgram = Program::Create("./shader/simple.vs", "./shader/simple.fs");
@@ -188,30 +278,61 @@ bool Context::Init() {
   m_program = Program::Create("./shader/lighting.vs", "./shader/lighting.fs");
   if (!m_program)
     return false;
+
+  m_instancedProgram = Program::Create("./shader/lighting_instanced.vs", "./shader/lighting.fs");
+  if (!m_instancedProgram)
+    return false;
+
+  m_instancedUniformScaleProgram = Program::Create(
+    "./shader/lighting_instanced_uniform_scale.vs", "./shader/lighting.fs");
+  if (!m_instancedUniformScaleProgram)
+    return false;
+
+  // attribute offset을 매 프레임 바꾸면 driver가 vertex fetch 설정을 다시 만들 수 있으므로
+  // 가능하면 attribute는 고정하고 base instance로 ring buffer 안의 위치를 지정
+  m_baseInstance = GLAD_GL_VERSION_4_2 || GLAD_GL_ARB_base_instance;
+  // draw 별 instance data는 base instance로 찾으므로 base instance도 필요
+  m_multiDrawIndirectSupported = m_baseInstance &&
+    (GLAD_GL_VERSION_4_3 || GLAD_GL_ARB_multi_draw_indirect);
+  m_scene = Scene::Create(m_cubeCount);
+  m_renderQueue = RenderQueue::Create(m_cubeCount + 1);
+  m_drawBatch = [this](const DrawItem& item, const uint32_t* transformIndices, size_t count) {
+    DrawBatch(item, transformIndices, count);
+  };
+  m_drawBatches = [this](const RenderQueue::Batch* batches, size_t batchCount,
+    const uint32_t* transformIndices) {
+    DrawBatches(batches, batchCount, transformIndices);
+  };
+  SetCubeCount(m_cubeCount);
+
+  // 모든 program이 FRAME_UNIFORM_BINDING에서 읽어가므로 한 번만 연결해두면 된다
+  m_frameUniformBuffer = Buffer::CreateWithData(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW,
+    nullptr, sizeof(FrameUniforms));
+  m_frameUniformBuffer->BindBase(FRAME_UNIFORM_BINDING);
   
   // 화면 클리어
   glClearColor(0.0f, 0.1f, 0.2f, 0.3f); // 컬러 프레임버퍼 화면을 클리어 할 색상 지정
   
 
-  auto image = Image::Load("./image/container.jpg");
-  m_texture = Texture::CreateFromImage(image.get());
-
-  auto image2 = Image::Load("./image/chillguy.png");
-  m_texture2 = Texture::CreateFromImage(image2.get());
-
-  m_material.diffuse = Texture::CreateFromImage(Image::Load("./image/container2.png").get());
-  
-  m_material.specular = Texture::CreateFromImage(Image::Load("./image/container2_specular.png").get()); 
+  // placeholder texture를 바로 받고 decode / upload는 뒤에서 진행 (첫 프레임을 기다리게 하지 않음)
+  m_textureStreamer = TextureStreamer::Create();
+  if (!m_textureStreamer)
+    return false;
+  m_texture = m_textureStreamer->Load("./image/container.jpg");
+  m_texture2 = m_textureStreamer->Load("./image/chillguy.png");
+  m_material.diffuse = m_textureStreamer->Load("./image/container2.png");
+  // specular map은 색이 아니라 세기 값이므로 linear 그대로 평균
+  MipmapOptions dataMipmap;
+  dataMipmap.srgb = false;
+  m_material.specular = m_textureStreamer->Load("./image/container2_specular.png", dataMipmap);
 
   // 두 개 이상의 이미지로 텍스처를 만드려면 텍스처 슬롯을 이용해야 한다.
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, m_texture->Get());
-  glActiveTexture(GL_TEXTURE1);
-  glBindTexture(GL_TEXTURE_2D, m_texture2->Get());
+  m_texture->Bind(0);
+  m_texture2->Bind(1);
 
   m_program->Use();
-  m_program->SetUniform("tex", 0);
-  m_program->SetUniform("tex2", 1);
+  m_program->SetUniform("tex"_uniform, 0);
+  m_program->SetUniform("tex2"_uniform, 1);
 
   return true;
 }
@@ -233,6 +354,14 @@ glDrawElements(primitive, count, type, pointer/offset)
   - pointer/offset: 그리고자 하는 EBO의 첫 데이터로부터의 오프셋
 */
 void Context::Render() {
+  GLState::BeginFrame();
+  // 지난 프레임 도중에 교체된 buffer는 이제 쓰는 draw item이 없음
+  m_retiredBuffers.clear();
+  {
+    ProfileScope scope(m_profiler, "TextureStreamer::Update");
+    m_textureStreamer->Update();
+  }
+
   if (ImGui::Begin("ui window")) {
     // color
     if (ImGui::ColorEdit4("clear color", glm::value_ptr(m_clearColor))) {
@@ -262,24 +391,63 @@ void Context::Render() {
     }
     // animation
     ImGui::Checkbox("animation", &m_animation);
+    // cube instancing
+    if (ImGui::DragInt("cubes", &m_cubeCount, 10.0f, 1, MAX_CUBE_COUNT))
+      SetCubeCount(m_cubeCount);
+    ImGui::Checkbox("instancing", &m_instancing);
+    ImGui::Checkbox("uniform scale shader", &m_uniformScaleShader);
+    ImGui::Text("updated transforms: %d", (int)m_scene->GetUpdatedCount());
+    // frustum culling
+    ImGui::Checkbox("frustum culling", &m_frustumCulling);
+    ImGui::Text("visible: %d, culled: %d", (int)m_visibleCount,
+      (int)(m_scene->GetObjectCount() - m_visibleCount));
+    ImGui::Text("culling (%s): %.3f ms", GetCullingImplementation(), m_cullingTime);
+    ImGui::Text("instance buffer (%s): %d stalls",
+      m_instanceBuffer->IsPersistentMapped() ? "persistent" : "map range",
+      (int)m_instanceBuffer->GetStallCount());
+    // mesh LOD 별 object 수 (큐브는 면마다 정점이 나뉘어 있어 LOD 0만 있음)
+    ImGui::Checkbox("mesh lod", &m_meshLod);
+    ImGui::Text("lod objects: %d / %d / %d / %d (%d levels)", (int)m_lodObjectCounts[0],
+      (int)m_lodObjectCounts[1], (int)m_lodObjectCounts[2], (int)m_lodObjectCounts[3],
+      (int)m_cubeLods.size());
+    ImGui::Text("render queue: %d items, %d batches", (int)m_renderQueue->GetItemCount(),
+      (int)m_renderQueue->GetBatchCount());
+    if (m_multiDrawIndirectSupported) {
+      ImGui::Checkbox("multi draw indirect", &m_multiDrawIndirect);
+      ImGui::Text("indirect: %d draws in %d calls", (int)m_indirectCommandCount,
+        (int)m_multiDrawCount);
+    }
+    // 지난 프레임에 GL로 전달된 / 캐시 덕분에 생략된 state 변경 호출 수
+    const auto& glStats = GLState::GetLastFrameStats();
+    ImGui::Text("gl calls: %d issued, %d elided (dsa: %s)", (int)glStats.issued,
+      (int)glStats.elided, GLState::HasDirectStateAccess() ? "on" : "off");
+    const auto& textureStats = m_textureStreamer->GetStats();
+    ImGui::Text("textures: %d pending, %d uploaded (%.1f MB), %d failed",
+      (int)textureStats.pendingCount, (int)textureStats.uploadedCount,
+      textureStats.uploadedBytes / (1024.0f * 1024.0f), (int)textureStats.failedCount);
+    ImGui::Text("texture mipmap (%s): generated on cpu", GetMipmapImplementation());
+    // mesh arena 사용량 (단편화 = 1 - 가장 큰 빈 블록 / 전체 빈 공간)
+    auto arenaStats = m_meshArena->GetStats();
+    ImGui::Text("mesh arena: %d meshes, vertices %d / %d, fragmentation %.2f",
+      (int)arenaStats.meshCount, (int)arenaStats.vertex.usedSize,
+      (int)arenaStats.vertex.size, arenaStats.vertex.fragmentation);
+    if (ImGui::Button("compact mesh arena"))
+      m_meshArena->Compact();
+    const auto& layoutStats = VertexLayoutCache::GetStats();
+    ImGui::Text("vao cache: %d layouts, %d hits, %d misses", (int)layoutStats.layoutCount,
+      (int)layoutStats.hitCount, (int)layoutStats.missCount);
+    // scope 별 CPU / GPU 시간 그래프
+    if (m_profiler && ImGui::CollapsingHeader("profiler"))
+      m_profiler->DrawImGui();
   }
   ImGui::End();
 
-  std::vector<glm::vec3> cubePositions = {
-    glm::vec3( 0.0f, 0.0f, 0.0f),
-    glm::vec3( 2.0f, 5.0f, -15.0f),
-    glm::vec3(-1.5f, -2.2f, -2.5f),
-    glm::vec3(-3.8f, -2.0f, -12.3f),
-    glm::vec3( 2.4f, -0.4f, -3.5f),
-    glm::vec3(-1.7f, 3.0f, -7.5f),
-    glm::vec3( 1.3f, -2.0f, -2.5f),
-    glm::vec3( 1.5f, 2.0f, -2.5f),
-    glm::vec3( 1.5f, 0.2f, -1.5f),
-    glm::vec3(-1.3f, 1.0f, -1.5f),
-  };
-
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-  glEnable(GL_DEPTH_TEST);
+  GLState::Enable(GL_DEPTH_TEST);
+  // Init()에서 바인딩한 VAO에 기대지 않고 매 프레임 지정 (바뀌지 않았으면 생략됨)
+  // arena가 compact 등으로 buffer를 바꿨을 수 있으므로 cache에서 다시 찾음 (대부분 hit)
+  UpdateCubeVertexLayout();
+  m_cubeVertexLayout->Bind();
 
   // 기존의 바라보는 방향인 (0, 0, -1)을 Pitch, Yaw만큼 각각의 축 따라 회전
   m_cameraFront =
@@ -288,47 +456,268 @@ void Context::Render() {
       glm::vec3(1.0f, 0.0f, 0.0f)) *
     glm::vec4(0.0f, 0.0f, -1.0f, 0.0f);
 
-  auto projection = glm::perspective(glm::radians(45.0f),
+  const float fovY = glm::radians(45.0f);
+  auto projection = glm::perspective(fovY,
     (float)m_width / (float)m_height, 0.01f, 40.0f);
   auto view = glm::lookAt(
     m_cameraPos,
     m_cameraPos + m_cameraFront,
     m_cameraUp);
 
-  // light box
-  auto lightModelTransform =
+  // 카메라, 조명 정보는 프레임 당 한 번만 업로드
+  m_frameUniforms.view = view;
+  m_frameUniforms.projection = projection;
+  m_frameUniforms.viewProjection = projection * view;
+  m_frameUniforms.viewPos = m_cameraPos;
+  m_frameUniforms.light.position = m_light.position;
+  m_frameUniforms.light.ambient = m_light.ambient;
+  m_frameUniforms.light.diffuse = m_light.diffuse;
+  m_frameUniforms.light.specular = m_light.specular;
+  m_frameUniformBuffer->UpdateData(&m_frameUniforms, sizeof(FrameUniforms));
+
+  // 바뀐 transform만 다시 계산
+  {
+    ProfileScope scope(m_profiler, "Scene::Update");
+    m_scene->Update(m_animation ? m_time : 0.0f);
+  }
+  auto cubeCount = m_scene->GetObjectCount();
+
+  // 화면에 보이는 큐브만 모아서 그린다
+  const uint32_t* cubeIndices = m_visibleIndices.data();
+  if (m_frustumCulling) {
+    ProfileScope scope(m_profiler, "Culling");
+    auto cullingStart = std::chrono::high_resolution_clock::now();
+    auto frustum = Frustum::FromMatrix(projection * view);
+    m_visibleCount = CullSpheres(frustum,
+      m_scene->GetBoundsX(), m_scene->GetBoundsY(), m_scene->GetBoundsZ(),
+      m_scene->GetBoundsRadius(), cubeCount, m_visibleIndices.data());
+    auto cullingEnd = std::chrono::high_resolution_clock::now();
+    m_cullingTime = std::chrono::duration<float, std::milli>(cullingEnd - cullingStart).count();
+  }
+  else {
+    cubeIndices = m_allIndices.data();
+    m_visibleCount = cubeCount;
+    m_cullingTime = 0.0f;
+  }
+
+  // draw item이 VAO를 가리키기 전에 이번 프레임 instance 구역을 확보
+  // Execute 도중에는 buffer를 교체하지 않음 (새 buffer는 BeginFrame()을 거치지 않았고
+  // 이미 제출된 item은 이전 buffer의 VAO를 가리킴)
+  ReserveInstanceBuffer(GetInstanceReserveCount(m_visibleCount));
+
+  auto program = m_program.get();
+  if (m_instancing) {
+    program = m_uniformScaleShader && !m_scene->HasNonUniformScale() ?
+      m_instancedUniformScaleProgram.get() : m_instancedProgram.get();
+  }
+  program->Use();
+  program->SetUniform("material.diffuse"_uniform, 0);
+  program->SetUniform("material.specular"_uniform, 1);
+  program->SetUniform("material.shininess"_uniform, m_material.shininess);
+
+  // 그릴 것들을 render queue에 넣고 정렬된 순서로 실행
+  m_lightModelTransform =
     glm::translate(glm::mat4(1.0), m_light.position) *
     glm::scale(glm::mat4(1.0), glm::vec3(0.1f));
-  m_simpleProgram->Use();
-  m_simpleProgram->SetUniform("color", glm::vec4(m_light.ambient + m_light.diffuse, 1.0f));
-  m_simpleProgram->SetUniform("transform", projection * view * lightModelTransform);
-  glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-  
-  m_program->Use();
-  m_program->SetUniform("viewPos", m_cameraPos);
-  m_program->SetUniform("light.position", m_light.position);
-  m_program->SetUniform("light.ambient", m_light.ambient);
-  m_program->SetUniform("light.diffuse", m_light.diffuse);
-  m_program->SetUniform("light.specular", m_light.specular);
-  m_program->SetUniform("material.diffuse", 0);
-  m_program->SetUniform("material.specular", 1);
-  m_program->SetUniform("material.shininess", m_material.shininess);
-
-  glActiveTexture(GL_TEXTURE0);
-  m_material.diffuse->Bind();
-  glActiveTexture(GL_TEXTURE1);
-  m_material.specular->Bind();
-
-
-  for (size_t i = 0; i < cubePositions.size(); i++){
-    auto& pos = cubePositions[i];
-    auto model = glm::translate(glm::mat4(1.0f), pos);
-    model = glm::rotate(model,
-      glm::radians((m_animation ? (float)glfwGetTime() : 0.0f) * 120.0f + 20.0f * (float)i),
-      glm::vec3(1.0f, 0.5f, 0.0f));
-    auto transform = projection * view * model;
-    m_program->SetUniform("transform", transform);
-    m_program->SetUniform("modelTransform", model);
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+  {
+    ProfileScope scope(m_profiler, "RenderQueue::Submit");
+    m_renderQueue->Clear();
+
+    // 조명 상자도 큐브 mesh를 그대로 사용
+    auto cubeMesh = m_meshArena->GetMeshRange(m_cubeMesh);
+    DrawItem lightItem;
+    lightItem.program = m_simpleProgram.get();
+    lightItem.drawKind = (uint8_t)DrawKind::LightBox;
+    lightItem.vertexLayout = m_cubeVertexLayout;
+    lightItem.firstIndex = cubeMesh.firstIndex + m_cubeLods[0].firstIndex;
+    lightItem.indexCount = m_cubeLods[0].indexCount;
+    lightItem.baseVertex = cubeMesh.baseVertex;
+    lightItem.depth = -(view * glm::vec4(m_light.position, 1.0f)).z;
+    m_renderQueue->Submit(lightItem);
+
+    // view space depth = view 행렬의 세 번째 행과 중심점의 내적
+    glm::vec4 depthRow = -glm::vec4(view[0][2], view[1][2], view[2][2], view[3][2]);
+    auto boundsX = m_scene->GetBoundsX();
+    auto boundsY = m_scene->GetBoundsY();
+    auto boundsZ = m_scene->GetBoundsZ();
+    DrawItem cubeItem;
+    cubeItem.program = program;
+    cubeItem.drawKind = (uint8_t)(m_instancing ? DrawKind::Instanced : DrawKind::PerObject);
+    cubeItem.textures[0] = m_material.diffuse.get();
+    cubeItem.textures[1] = m_material.specular.get();
+    cubeItem.vertexLayout = m_cubeVertexLayout;
+    cubeItem.baseVertex = cubeMesh.baseVertex;
+    // LOD는 같은 정점을 쓰고 index 범위만 다름
+    auto boundsRadius = m_scene->GetBoundsRadius();
+    auto lodLevels = m_scene->GetLodLevels();
+    uint32_t lodCount = m_meshLod ? (uint32_t)m_cubeLods.size() : 1;
+    float projectionScale = 1.0f / std::tan(fovY * 0.5f);
+    std::fill(std::begin(m_lodObjectCounts), std::end(m_lodObjectCounts), 0);
+    for (size_t i = 0; i < m_visibleCount; i++) {
+      auto index = cubeIndices[i];
+      cubeItem.depth = depthRow.x * boundsX[index] + depthRow.y * boundsY[index] +
+        depthRow.z * boundsZ[index] + depthRow.w;
+      uint32_t lod = SelectLod(GetScreenSize(boundsRadius[index], cubeItem.depth, projectionScale),
+        lodLevels[index], lodCount);
+      lodLevels[index] = (uint8_t)lod;
+      m_lodObjectCounts[lod]++;
+      cubeItem.firstIndex = cubeMesh.firstIndex + m_cubeLods[lod].firstIndex;
+      cubeItem.indexCount = m_cubeLods[lod].indexCount;
+      cubeItem.transformIndex = index;
+      m_renderQueue->Submit(cubeItem);
+    }
+  }
+
+  ProfileScope scope(m_profiler, "RenderQueue::Execute");
+  if (m_benchmark)
+    m_benchmark->BeginGeometryPass();
+  // instance buffer는 프레임마다 다른 구역에 쓰고, GPU가 다 읽었는지는 fence로 확인
+  m_instanceBuffer->BeginFrame();
+  m_multiDrawCount = 0;
+  m_indirectCommandCount = 0;
+  if (m_multiDrawIndirectSupported && m_multiDrawIndirect) {
+    m_indirectBuffer->BeginFrame();
+    m_renderQueue->Execute(m_drawBatch, m_drawBatches);
+    m_indirectBuffer->EndFrame();
+  }
+  else {
+    m_renderQueue->Execute(m_drawBatch);
+  }
+  m_instanceBuffer->EndFrame();
+  if (m_benchmark)
+    m_benchmark->EndGeometryPass();
+}
+
+/*
+state가 같은 batch 묶음(LOD가 다른 큐브 등)을 glMultiDrawElementsIndirect() 한 번으로 그림
+  - instance data는 묶음 전체를 instance buffer에 이어서 쓰고
+    batch 마다 command의 base instance로 자기 구간을 가리킴 (instanced attribute가 그 위치부터 읽힘)
+  - command는 streaming indirect buffer에 CPU가 직접 씀
+  - 큐브 instancing이 아닌 batch(조명 상자, instancing 끔)는 batch마다 DrawBatch()
+*/
+void Context::DrawBatches(const RenderQueue::Batch* batches, size_t batchCount,
+  const uint32_t* transformIndices) {
+  if ((DrawKind)batches[0].item->drawKind != DrawKind::Instanced) {
+    for (size_t i = 0; i < batchCount; i++) {
+      DrawBatch(*batches[i].item, transformIndices + batches[i].firstTransform,
+        batches[i].transformCount);
+    }
+    return;
+  }
+  SetVertexDecodeUniforms(batches[0].item->program);
+  SetTextureOrientationUniforms(*batches[0].item);
+
+  // 같은 state의 batch는 정렬된 transform 목록에서 연속된 구간
+  uint32_t firstTransform = batches[0].firstTransform;
+  const auto& lastBatch = batches[batchCount - 1];
+  size_t instanceCount = lastBatch.firstTransform + lastBatch.transformCount - firstTransform;
+  size_t instanceSize = sizeof(CubeInstance) * instanceCount;
+  size_t commandSize = sizeof(DrawElementsIndirectCommand) * batchCount;
+  auto instanceAllocation = m_instanceBuffer->Allocate(instanceSize, sizeof(CubeInstance));
+  auto commandAllocation = m_indirectBuffer->Allocate(commandSize);
+  // 이번 프레임 구역은 Render()에서 미리 확보함
+  // 여기서 buffer를 교체하면 BeginFrame()을 거치지 않은 buffer를 쓰게 되므로 건너뜀
+  if (!instanceAllocation.data || !commandAllocation.data) {
+    SPDLOG_ERROR("instance buffer overflow: {} instances, {} reserved",
+      instanceCount, m_instanceCapacity);
+    return;
+  }
+
+  auto cubeTransforms = m_scene->GetTransforms();
+  auto normalMatrices = m_scene->GetNormalMatrices();
+  auto instances = (CubeInstance*)instanceAllocation.data;
+  for (size_t i = 0; i < instanceCount; i++) {
+    auto index = transformIndices[firstTransform + i];
+    instances[i] = { cubeTransforms[index], normalMatrices[index] };
+  }
+  auto baseInstance = (uint32_t)(instanceAllocation.offset / sizeof(CubeInstance));
+  auto commands = (DrawElementsIndirectCommand*)commandAllocation.data;
+  for (size_t i = 0; i < batchCount; i++) {
+    const auto& batch = batches[i];
+    commands[i] = { batch.item->indexCount, batch.transformCount, batch.item->firstIndex,
+      batch.item->baseVertex, baseInstance + batch.firstTransform - firstTransform };
+  }
+  m_instanceBuffer->Commit();
+  m_indirectBuffer->Commit();
+
+  m_indirectBuffer->Bind();
+  glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+    (const void*)commandAllocation.offset, (GLsizei)batchCount, 0);
+  m_multiDrawCount++;
+  m_indirectCommandCount += batchCount;
+}
+
+// 양자화된 position / octahedral normal을 vertex shader에서 풀기 위한 값
+void Context::SetVertexDecodeUniforms(const Program* program) const {
+  program->SetUniform("positionScale"_uniform, m_cubePositionScale);
+  program->SetUniform("positionOffset"_uniform, m_cubePositionOffset);
+  program->SetUniform("octahedralNormal"_uniform, m_octahedralNormal ? 1 : 0);
+}
+
+// 위 줄부터 저장된 texture(.dds 등)는 올린 data를 고치지 않고 shader가 v를 뒤집어 읽음
+void Context::SetTextureOrientationUniforms(const DrawItem& item) const {
+  auto topDown = [](const Texture* texture) { return texture && texture->IsTopDown() ? 1 : 0; };
+  item.program->SetUniform("material.diffuseTopDown"_uniform, topDown(item.textures[0]));
+  item.program->SetUniform("material.specularTopDown"_uniform, topDown(item.textures[1]));
+}
+
+// render queue가 state를 맞춘 뒤 batch 마다 호출
+void Context::DrawBatch(const DrawItem& item, const uint32_t* transformIndices, size_t count) {
+  auto indexOffset = (const void*)(sizeof(uint32_t) * item.firstIndex);
+  auto program = item.program;
+  SetVertexDecodeUniforms(program);
+
+  // light box
+  if ((DrawKind)item.drawKind == DrawKind::LightBox) {
+    program->SetUniform("color"_uniform, glm::vec4(m_light.ambient + m_light.diffuse, 1.0f));
+    program->SetUniform("modelTransform"_uniform, m_lightModelTransform);
+    glDrawElementsBaseVertex(GL_TRIANGLES, item.indexCount, GL_UNSIGNED_INT,
+      indexOffset, item.baseVertex);
+    return;
+  }
+  SetTextureOrientationUniforms(item);
+
+  auto cubeTransforms = m_scene->GetTransforms();
+  auto normalMatrices = m_scene->GetNormalMatrices();
+  if ((DrawKind)item.drawKind == DrawKind::Instanced) {
+    // instance data를 streaming buffer에 바로 쓰고 draw call 하나로 batch의 모든 큐브를 그림
+    // base instance로 위치를 넘기려면 offset이 instance 크기의 배수여야 한다
+    size_t alignment = m_baseInstance ? sizeof(CubeInstance) : 16;
+    auto allocation = m_instanceBuffer->Allocate(sizeof(CubeInstance) * count, alignment);
+    // 이번 프레임 구역은 Render()에서 미리 확보함
+    if (!allocation.data) {
+      SPDLOG_ERROR("instance buffer overflow: {} instances, {} reserved",
+        count, m_instanceCapacity);
+      return;
+    }
+    auto instances = (CubeInstance*)allocation.data;
+    for (size_t i = 0; i < count; i++) {
+      auto index = transformIndices[i];
+      instances[i] = { cubeTransforms[index], normalMatrices[index] };
+    }
+    m_instanceBuffer->Commit();
+    if (m_baseInstance) {
+      glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, item.indexCount,
+        GL_UNSIGNED_INT, indexOffset, (GLsizei)count, item.baseVertex,
+        (GLuint)(allocation.offset / sizeof(CubeInstance)));
+    }
+    else {
+      SetInstanceAttribs(allocation.offset);
+      glDrawElementsInstancedBaseVertex(GL_TRIANGLES, item.indexCount, GL_UNSIGNED_INT,
+        indexOffset, (GLsizei)count, item.baseVertex);
+    }
+  }
+  else {
+    for (size_t i = 0; i < count; i++) {
+      auto index = transformIndices[i];
+      const auto& normal = normalMatrices[index];
+      program->SetUniform("modelTransform"_uniform, cubeTransforms[index]);
+      program->SetUniform("normalTransform"_uniform, glm::mat3(
+        glm::vec3(normal.columns[0]),
+        glm::vec3(normal.columns[1]),
+        glm::vec3(normal.columns[2])));
+      glDrawElementsBaseVertex(GL_TRIANGLES, item.indexCount, GL_UNSIGNED_INT,
+        indexOffset, item.baseVertex);
+    }
   }
 }
\ No newline at end of file
@@ -6,32 +6,159 @@
 #include "program.h"
 #include "buffer.h"
 #include "vertex_layout.h"
+#include "buffer_arena.h"
+#include "mesh_lod.h"
 #include "texture.h"
+#include "texture_streamer.h"
+#include "frame_uniforms.h"
+#include "scene.h"
+#include "frustum.h"
+#include "render_queue.h"
+#include "profiler.h"
+#include "benchmark.h"
+
+// normal matrix: vec4로 padding된 열 3개의 xyz만 읽음 (location 3개)
+template <>
+struct VertexAttribTraits<NormalMatrix>
+  : VertexAttribTraitsBase<3, GL_FLOAT, false, 3, sizeof(glm::vec4)> {};
 
 CLASS_PTR(Context)
 class Context {
 public:
   static ContextUPtr Create();
+  ~Context();
   void Render();
   void ProcessInput(GLFWwindow* window);
   void Reshape(int width, int height);
   void MouseMove(double x, double y);
   void MouseButton(int button, int action, double x, double y);
+  // 애니메이션 기준 시간 (headless 모드에서는 고정된 간격으로 진행)
+  void SetTime(float time) { m_time = time; }
+  // 그릴 큐브 개수와 instancing 사용 여부 (benchmark에서 scaling 측정용)
+  void SetCubeCount(int count);
+  void SetInstancing(bool instancing) { m_instancing = instancing; }
+  void SetFrustumCulling(bool frustumCulling) { m_frustumCulling = frustumCulling; }
+  void SetUniformScaleShader(bool uniformScaleShader) { m_uniformScaleShader = uniformScaleShader; }
+  void SetMeshLod(bool meshLod) { m_meshLod = meshLod; }
+  void SetMultiDrawIndirect(bool multiDrawIndirect) { m_multiDrawIndirect = multiDrawIndirect; }
+  // 소유권은 main에 있음 (nullptr이면 측정하지 않음)
+  void SetProfiler(Profiler* profiler) { m_profiler = profiler; }
+  // --bench 중 geometry pass의 GPU 시간 측정용 (소유권은 main, nullptr이면 측정하지 않음)
+  void SetBenchmark(FrameBenchmark* benchmark) { m_benchmark = benchmark; }
+  // 비동기로 읽고 있는 texture가 모두 올라갈 때까지 대기
+  void FinishTextureLoads() { m_textureStreamer->Finish(); }
 
 private:
   Context() {}
   bool Init();
+  // DrawItem::drawKind: batch를 그리는 방법 (program이 아니라 submit할 때 정함)
+  enum class DrawKind : uint8_t {
+    PerObject = 0,  // object마다 transform uniform을 넣고 draw call
+    Instanced = 1,  // instance buffer + instanced draw / multi draw indirect
+    LightBox = 2,   // transform 없이 조명 색과 m_lightModelTransform으로 그림
+  };
+  size_t GetInstanceReserveCount(size_t instanceCount) const;
+  void ReserveInstanceBuffer(size_t instanceCount);
+  void SetInstanceAttribs(size_t offset);
+  void UpdateCubeVertexLayout();
+  void DrawBatch(const DrawItem& item, const uint32_t* transformIndices, size_t count);
+  void DrawBatches(const RenderQueue::Batch* batches, size_t batchCount,
+    const uint32_t* transformIndices);
+  void SetVertexDecodeUniforms(const Program* program) const;
+  void SetTextureOrientationUniforms(const DrawItem& item) const;
   ProgramUPtr m_program;
   ProgramUPtr m_simpleProgram;
+  ProgramUPtr m_instancedProgram;
+  ProgramUPtr m_instancedUniformScaleProgram;
+
+  // 모든 mesh의 정점 / 인덱스를 담는 공용 buffer (VAO도 하나를 공유)
+  BufferArenaUPtr m_meshArena;
+  uint32_t m_cubeMesh { BufferArena::INVALID_MESH };
+  // 압축 정점 복원 값 (arena의 mesh는 모두 같은 형식, position scale / offset은 mesh 별)
+  glm::vec3 m_cubePositionScale { glm::vec3(1.0f) };
+  glm::vec3 m_cubePositionOffset { glm::vec3(0.0f) };
+  bool m_octahedralNormal { false };
+  // 큐브 mesh의 LOD 별 index 범위 (mesh 안의 offset, 파일에 LOD가 하나면 원본만)
+  std::vector<MeshLod> m_cubeLods;
+  // image decode는 worker thread, upload는 Render() 시작 시 budget 안에서
+  TextureStreamerUPtr m_textureStreamer;
+  TexturePtr m_texture;
+  TexturePtr m_texture2;
+
+  // 카메라/조명 정보를 담는 프레임 공용 uniform buffer
+  BufferUPtr m_frameUniformBuffer;
+  FrameUniforms m_frameUniforms;
+
+  // instance 별로 GPU에 올라가는 데이터 (model matrix + normal matrix)
+  struct CubeInstance {
+    glm::mat4 model;
+    NormalMatrix normal;
+  };
+  // model matrix: location 3 ~ 6, normal matrix: location 7 ~ 9
+  static constexpr VertexFormat CUBE_INSTANCE_FORMAT = MakeVertexFormat<CubeInstance>(
+    VERTEX_ATTRIB(CubeInstance, model, 3),
+    VERTEX_ATTRIB(CubeInstance, normal, 7));
+
+  // cube instancing
+  static constexpr int MAX_CUBE_COUNT = 100000;
+  int m_cubeCount { 10 };
+  bool m_instancing { true };
+  SceneUPtr m_scene;
+  std::vector<uint32_t> m_cubeIds;
+  BufferUPtr m_instanceBuffer;
+  // 프레임 도중에 교체된 instance / indirect buffer: 이미 제출된 draw item이 가리키는 VAO가
+  // cache에서 지워지지 않도록 다음 프레임까지 보관 (한 프레임에 여러 번 교체될 수 있음)
+  std::vector<BufferUPtr> m_retiredBuffers;
+  size_t m_instanceCapacity { 0 };
+  // mesh arena + instance buffer를 연결한 VAO
+  // (VertexLayoutCache 소유, base instance가 없으면 instance offset을 바꾸는 m_instanceOffsetLayout)
+  const VertexLayout* m_cubeVertexLayout { nullptr };
+  VertexLayoutUPtr m_instanceOffsetLayout;
+  // glDrawElementsInstancedBaseInstance 사용 가능 여부 (GL 4.2)
+  bool m_baseInstance { false };
+  // glMultiDrawElementsIndirect 사용 가능 여부 (GL 4.3) / 사용 여부
+  bool m_multiDrawIndirectSupported { false };
+  bool m_multiDrawIndirect { true };
+  // multi draw indirect의 draw 별 인자 (GL이 정한 layout)
+  struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+  };
+  // 매 프레임 새로 쓰는 draw command (batch 수 <= instance 수이므로 instance buffer와 같은 개수)
+  BufferUPtr m_indirectBuffer;
+  // 지난 프레임의 glMultiDrawElementsIndirect 호출 수 / 그 안의 draw command 수
+  size_t m_multiDrawCount { 0 };
+  size_t m_indirectCommandCount { 0 };
+  // 모든 object의 scale이 균일하면 shader에서 mat3(model)로 normal을 변환
+  bool m_uniformScaleShader { true };
+
+  // frustum culling
+  bool m_frustumCulling { true };
+  std::vector<uint32_t> m_visibleIndices;
+  // culling을 끈 경우 사용하는 0, 1, 2, ... index
+  std::vector<uint32_t> m_allIndices;
+  size_t m_visibleCount { 0 };
+  float m_cullingTime { 0.0f };
+
+  // mesh LOD: 화면에 투영된 크기로 object마다 고름
+  bool m_meshLod { true };
+  uint32_t m_lodObjectCounts[MeshLod::MAX_COUNT] {};
+
+  // render queue (매 프레임 다시 채워서 정렬 후 실행)
+  RenderQueueUPtr m_renderQueue;
+  RenderQueue::DrawBatchFunc m_drawBatch;
+  RenderQueue::MultiDrawFunc m_drawBatches;
+  glm::mat4 m_lightModelTransform { glm::mat4(1.0f) };
 
-  VertexLayoutUPtr m_vertexLayout;
-  BufferUPtr m_vertexBuffer;
-  BufferUPtr m_indexBuffer;
-  TextureUPtr m_texture;
-  TextureUPtr m_texture2;
+  Profiler* m_profiler { nullptr };
+  FrameBenchmark* m_benchmark { nullptr };
 
   // animation
   bool m_animation = { true };
+  float m_time { 0.0f };
 
   // clear color
   glm::vec4 m_clearColor { glm::vec4(0.1f, 0.2f, 0.3f, 0.0f) };
@@ -47,8 +174,8 @@ private:
 
   // material parameter
   struct Material {
-    TextureUPtr diffuse;
-    TextureUPtr specular;
+    TexturePtr diffuse;
+    TexturePtr specular;
     float shininess { 32.0f };
   };
   Material m_material;
@@ -0,0 +1,200 @@
+#include "dds_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// 압축 안 된 형식: channel mask로 byte 순서를 구분 (RGBA / BGRA 등)
+bool GetUncompressedFormat(const DdsPixelFormat& pixelFormat, TextureFormat& format) {
+  bool alpha = (pixelFormat.flags & DdsPixelFormat::FLAG_ALPHAPIXELS) && pixelFormat.aBitMask;
+  if (pixelFormat.flags & DdsPixelFormat::FLAG_LUMINANCE) {
+    if (pixelFormat.rgbBitCount != 8 || alpha)
+      return false;
+    format = { GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1 };
+    return true;
+  }
+  if (!(pixelFormat.flags & DdsPixelFormat::FLAG_RGB))
+    return false;
+  bool rgbOrder = pixelFormat.rBitMask == 0x000000ff && pixelFormat.gBitMask == 0x0000ff00 &&
+    pixelFormat.bBitMask == 0x00ff0000;
+  bool bgrOrder = pixelFormat.rBitMask == 0x00ff0000 && pixelFormat.gBitMask == 0x0000ff00 &&
+    pixelFormat.bBitMask == 0x000000ff;
+  if (!rgbOrder && !bgrOrder)
+    return false;
+  if (pixelFormat.rgbBitCount == 32) {
+    // alpha가 없는 X8 형식은 RGB8로 저장해서 sampling할 때 alpha가 1
+    format = { alpha ? (uint32_t)GL_RGBA8 : (uint32_t)GL_RGB8,
+      rgbOrder ? (uint32_t)GL_RGBA : (uint32_t)GL_BGRA, GL_UNSIGNED_BYTE, 4 };
+    return true;
+  }
+  if (pixelFormat.rgbBitCount == 24 && !alpha) {
+    format = { GL_RGB8, rgbOrder ? (uint32_t)GL_RGB : (uint32_t)GL_BGR, GL_UNSIGNED_BYTE, 3 };
+    return true;
+  }
+  return false;
+}
+
+// DXGI_FORMAT 값 (_SRGB도 같은 GL 형식: Image 경로처럼 sRGB texture 형식을 쓰지 않음)
+bool GetDxgiFormat(uint32_t dxgiFormat, TextureFormat& format) {
+  switch (dxgiFormat) {
+    case 28: case 29: // R8G8B8A8_UNORM(_SRGB)
+      format = { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4 };
+      return true;
+    case 87: case 91: // B8G8R8A8_UNORM(_SRGB)
+      format = { GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE, 4 };
+      return true;
+    case 61: // R8_UNORM
+      format = { GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1 };
+      return true;
+    case 71: case 72: // BC1_UNORM(_SRGB)
+      format = { GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 0, 0, 8 };
+      return true;
+    case 74: case 75: // BC2_UNORM(_SRGB)
+      format = { GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 0, 0, 16 };
+      return true;
+    case 77: case 78: // BC3_UNORM(_SRGB)
+      format = { GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 0, 0, 16 };
+      return true;
+    case 98: case 99: // BC7_UNORM(_SRGB)
+      format = { GL_COMPRESSED_RGBA_BPTC_UNORM, 0, 0, 16 };
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+bool DdsFile::IsDdsFile(const uint8_t* data, size_t size) {
+  uint32_t magic = 0;
+  if (size < sizeof(magic))
+    return false;
+  memcpy(&magic, data, sizeof(magic));
+  return magic == DdsHeader::MAGIC;
+}
+
+// DDS에는 level 위치 목록이 없어서 header 뒤에 level 0부터 크기대로 이어져 있다고 보고 계산
+bool DdsFile::Parse(const std::string& filename, const uint8_t* data, size_t size,
+  TextureFormat& format, std::vector<TextureLevelData>& levels, bool& topDown) {
+  topDown = true;
+  size_t offset = sizeof(uint32_t) + sizeof(DdsHeader);
+  if (size < offset) {
+    SPDLOG_ERROR("dds file too small: {}", filename);
+    return false;
+  }
+  // mapping은 페이지 단위로 정렬되어 있고 magic이 4byte라 header를 그대로 읽어도 된다
+  const auto& header = *(const DdsHeader*)(data + sizeof(uint32_t));
+  if (header.size != sizeof(DdsHeader) || header.pixelFormat.size != sizeof(DdsPixelFormat)) {
+    SPDLOG_ERROR("invalid dds header: {}", filename);
+    return false;
+  }
+  if ((header.caps2 & (DdsHeader::CAPS2_CUBEMAP | DdsHeader::CAPS2_VOLUME)) || header.depth > 1) {
+    SPDLOG_ERROR("dds cube map / volume texture not supported: {}", filename);
+    return false;
+  }
+
+  const auto& pixelFormat = header.pixelFormat;
+  bool supported = false;
+  if (!(pixelFormat.flags & DdsPixelFormat::FLAG_FOURCC)) {
+    supported = GetUncompressedFormat(pixelFormat, format);
+  }
+  else if (pixelFormat.fourCC == MakeFourCC('D', 'X', '1', '0')) {
+    if (size < offset + sizeof(DdsHeaderDxt10)) {
+      SPDLOG_ERROR("dds file too small: {}", filename);
+      return false;
+    }
+    const auto& header10 = *(const DdsHeaderDxt10*)(data + offset);
+    offset += sizeof(DdsHeaderDxt10);
+    if (header10.resourceDimension != DdsHeaderDxt10::DIMENSION_TEXTURE2D ||
+      (header10.miscFlag & DdsHeaderDxt10::MISC_TEXTURECUBE) || header10.arraySize > 1) {
+      SPDLOG_ERROR("dds texture is not a single 2D texture: {}", filename);
+      return false;
+    }
+    supported = GetDxgiFormat(header10.dxgiFormat, format);
+  }
+  else if (pixelFormat.fourCC == MakeFourCC('D', 'X', 'T', '1')) {
+    // 3색 + 투명 mode block이 있을 수 있어 RGBA 형식으로 올림
+    format = { GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 0, 0, 8 };
+    supported = true;
+  }
+  else if (pixelFormat.fourCC == MakeFourCC('D', 'X', 'T', '3')) {
+    format = { GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 0, 0, 16 };
+    supported = true;
+  }
+  else if (pixelFormat.fourCC == MakeFourCC('D', 'X', 'T', '5')) {
+    format = { GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 0, 0, 16 };
+    supported = true;
+  }
+  if (!supported) {
+    SPDLOG_ERROR("unsupported dds pixel format (flags {:#x}, fourCC {:#x}, {} bits): {}",
+      pixelFormat.flags, pixelFormat.fourCC, pixelFormat.rgbBitCount, filename);
+    return false;
+  }
+
+  if (header.width == 0 || header.height == 0 || header.width > (1 << 16) ||
+    header.height > (1 << 16)) {
+    SPDLOG_ERROR("invalid dds size {}x{}: {}", header.width, header.height, filename);
+    return false;
+  }
+  int width = (int)header.width;
+  int height = (int)header.height;
+  uint32_t levelCount = (header.flags & DdsHeader::FLAG_MIPMAPCOUNT) ?
+    std::max(header.mipMapCount, 1u) : 1;
+  // 크기가 맞지 않는 level 수는 TextureFile에서 거르므로 여기서는 위치만 확인
+  levelCount = std::min(levelCount, 32u);
+  levels.clear();
+  for (uint32_t i = 0; i < levelCount; i++) {
+    TextureLevelData level;
+    level.width = std::max(width >> i, 1);
+    level.height = std::max(height >> i, 1);
+    level.size = format.GetLevelSize(level.width, level.height);
+    if (level.size > size - offset) {
+      SPDLOG_ERROR("dds level {} out of file range: {}", i, filename);
+      return false;
+    }
+    level.data = data + offset;
+    offset += level.size;
+    levels.push_back(level);
+  }
+  return true;
+}
+
+bool DdsFile::Write(const std::string& filename, const CompressedImage& image) {
+  if (image.levels.empty()) {
+    SPDLOG_ERROR("no texture level to write: {}", filename);
+    return false;
+  }
+  const auto& base = image.levels[0];
+  DdsHeader header;
+  header.flags = DdsHeader::FLAG_CAPS | DdsHeader::FLAG_HEIGHT | DdsHeader::FLAG_WIDTH |
+    DdsHeader::FLAG_PIXELFORMAT | DdsHeader::FLAG_LINEARSIZE;
+  header.width = base.width;
+  header.height = base.height;
+  header.pitchOrLinearSize = (uint32_t)base.data.size();
+  header.mipMapCount = (uint32_t)image.levels.size();
+  header.caps = DdsHeader::CAPS_TEXTURE;
+  if (image.levels.size() > 1) {
+    header.flags |= DdsHeader::FLAG_MIPMAPCOUNT;
+    header.caps |= DdsHeader::CAPS_COMPLEX | DdsHeader::CAPS_MIPMAP;
+  }
+  header.pixelFormat.flags = DdsPixelFormat::FLAG_FOURCC;
+  header.pixelFormat.fourCC = image.format == BlockFormat::BC1 ?
+    MakeFourCC('D', 'X', 'T', '1') : MakeFourCC('D', 'X', 'T', '5');
+
+  std::ofstream fout(filename, std::ios::binary);
+  if (!fout.is_open()) {
+    SPDLOG_ERROR("failed to open file: {}", filename);
+    return false;
+  }
+  uint32_t magic = DdsHeader::MAGIC;
+  fout.write((const char*)&magic, sizeof(magic));
+  fout.write((const char*)&header, sizeof(header));
+  for (const auto& level : image.levels)
+    fout.write((const char*)level.data.data(), level.data.size());
+  if (!fout) {
+    SPDLOG_ERROR("failed to write file: {}", filename);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,92 @@
+#ifndef __DDS_FILE_H__
+#define __DDS_FILE_H__
+
+#include "common.h"
+#include "texture_compressor.h"
+#include "texture_file.h"
+
+/*
+** DDS (DirectDraw Surface) 파일
+  | "DDS " | DdsHeader (124byte) | level 0 block | level 1 block | ... |
+  - texture_converter가 BC1 / BC3 (FourCC "DXT1" / "DXT5")로 mip level 전체를 저장
+  - 읽기(TextureFile): FourCC DXT1 / DXT3 / DXT5, 압축 안 된 8 / 24 / 32bit RGB(A),
+    DX10 확장 header(BC1 / BC2 / BC3 / BC7, RGBA8 / BGRA8, R8)
+  - 줄 순서는 DDS 표준대로 위 줄부터 (Write()는 받은 block을 그대로 쓰므로 호출하는 쪽에서 맞춤)
+  - 모든 값은 little endian
+*/
+struct DdsPixelFormat {
+  static constexpr uint32_t FLAG_ALPHAPIXELS = 0x1;
+  static constexpr uint32_t FLAG_FOURCC = 0x4;
+  static constexpr uint32_t FLAG_RGB = 0x40;
+  static constexpr uint32_t FLAG_LUMINANCE = 0x20000;
+
+  uint32_t size { sizeof(DdsPixelFormat) };
+  uint32_t flags { 0 };
+  uint32_t fourCC { 0 };
+  uint32_t rgbBitCount { 0 };
+  uint32_t rBitMask { 0 };
+  uint32_t gBitMask { 0 };
+  uint32_t bBitMask { 0 };
+  uint32_t aBitMask { 0 };
+};
+
+struct DdsHeader {
+  static constexpr uint32_t MAGIC = 0x20534444; // "DDS "
+  static constexpr uint32_t FLAG_CAPS = 0x1;
+  static constexpr uint32_t FLAG_HEIGHT = 0x2;
+  static constexpr uint32_t FLAG_WIDTH = 0x4;
+  static constexpr uint32_t FLAG_PIXELFORMAT = 0x1000;
+  static constexpr uint32_t FLAG_MIPMAPCOUNT = 0x20000;
+  static constexpr uint32_t FLAG_LINEARSIZE = 0x80000;
+  static constexpr uint32_t CAPS_COMPLEX = 0x8;
+  static constexpr uint32_t CAPS_TEXTURE = 0x1000;
+  static constexpr uint32_t CAPS_MIPMAP = 0x400000;
+  static constexpr uint32_t CAPS2_CUBEMAP = 0x200;
+  static constexpr uint32_t CAPS2_VOLUME = 0x200000;
+
+  uint32_t size { sizeof(DdsHeader) };
+  uint32_t flags { 0 };
+  uint32_t height { 0 };
+  uint32_t width { 0 };
+  uint32_t pitchOrLinearSize { 0 };
+  uint32_t depth { 0 };
+  uint32_t mipMapCount { 0 };
+  uint32_t reserved1[11] {};
+  DdsPixelFormat pixelFormat;
+  uint32_t caps { 0 };
+  uint32_t caps2 { 0 };
+  uint32_t caps3 { 0 };
+  uint32_t caps4 { 0 };
+  uint32_t reserved2 { 0 };
+};
+static_assert(sizeof(DdsHeader) == 124, "dds header layout changed");
+
+// FourCC가 "DX10"이면 DdsHeader 바로 뒤에 오는 확장 header (DXGI_FORMAT으로 형식 지정)
+struct DdsHeaderDxt10 {
+  static constexpr uint32_t DIMENSION_TEXTURE2D = 3;
+  static constexpr uint32_t MISC_TEXTURECUBE = 0x4;
+
+  uint32_t dxgiFormat { 0 };
+  uint32_t resourceDimension { 0 };
+  uint32_t miscFlag { 0 };
+  uint32_t arraySize { 0 };
+  uint32_t miscFlags2 { 0 };
+};
+static_assert(sizeof(DdsHeaderDxt10) == 20, "dds dx10 header layout changed");
+
+constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+  return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) |
+    ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+}
+
+class DdsFile {
+public:
+  static bool IsDdsFile(const uint8_t* data, size_t size);
+  // header를 확인하고 level마다 data 안의 위치를 채움 (filename은 에러 출력용)
+  // DDS에는 방향 정보가 없어 topDown은 항상 true
+  static bool Parse(const std::string& filename, const uint8_t* data, size_t size,
+    TextureFormat& format, std::vector<TextureLevelData>& levels, bool& topDown);
+  static bool Write(const std::string& filename, const CompressedImage& image);
+};
+
+#endif // __DDS_FILE_H__
@@ -0,0 +1,62 @@
+#include "frame_uniforms.h"
+#include <cstddef>
+
+namespace {
+
+struct UniformBlockMember {
+  const char* name;
+  size_t offset;
+};
+
+const UniformBlockMember FRAME_UNIFORM_MEMBERS[] = {
+  { "view", offsetof(FrameUniforms, view) },
+  { "projection", offsetof(FrameUniforms, projection) },
+  { "viewProjection", offsetof(FrameUniforms, viewProjection) },
+  { "viewPos", offsetof(FrameUniforms, viewPos) },
+  { "light.position", offsetof(FrameUniforms, light) + offsetof(LightUniforms, position) },
+  { "light.ambient", offsetof(FrameUniforms, light) + offsetof(LightUniforms, ambient) },
+  { "light.diffuse", offsetof(FrameUniforms, light) + offsetof(LightUniforms, diffuse) },
+  { "light.specular", offsetof(FrameUniforms, light) + offsetof(LightUniforms, specular) },
+};
+
+} // namespace
+
+/*
+glGetUniformBlockIndex(): 이름으로 uniform block의 index 조회
+glGetActiveUniformBlockiv(GL_UNIFORM_BLOCK_DATA_SIZE): block 전체 크기
+glGetUniformIndices() + glGetActiveUniformsiv(GL_UNIFORM_OFFSET): block 내 멤버의 byte offset
+glUniformBlockBinding(): block을 binding point에 연결
+  (GLSL 330에서는 layout(binding = N)을 쓸 수 없으므로 링크 후에 지정)
+*/
+bool BindFrameUniformBlock(uint32_t program) {
+  auto blockIndex = glGetUniformBlockIndex(program, FRAME_UNIFORM_BLOCK_NAME);
+  if (blockIndex == GL_INVALID_INDEX)
+    return true;
+
+  int blockSize = 0;
+  glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize);
+  if ((size_t)blockSize != sizeof(FrameUniforms)) {
+    SPDLOG_ERROR("{} block size mismatch: shader {}, c++ {}",
+      FRAME_UNIFORM_BLOCK_NAME, blockSize, sizeof(FrameUniforms));
+    return false;
+  }
+
+  for (auto& member : FRAME_UNIFORM_MEMBERS) {
+    uint32_t index = GL_INVALID_INDEX;
+    glGetUniformIndices(program, 1, &member.name, &index);
+    if (index == GL_INVALID_INDEX) {
+      SPDLOG_ERROR("{} block has no member: {}", FRAME_UNIFORM_BLOCK_NAME, member.name);
+      return false;
+    }
+    int offset = -1;
+    glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &offset);
+    if ((size_t)offset != member.offset) {
+      SPDLOG_ERROR("{}.{} offset mismatch: shader {}, c++ {}",
+        FRAME_UNIFORM_BLOCK_NAME, member.name, offset, member.offset);
+      return false;
+    }
+  }
+
+  glUniformBlockBinding(program, blockIndex, FRAME_UNIFORM_BINDING);
+  return true;
+}
@@ -0,0 +1,44 @@
+#ifndef __FRAME_UNIFORMS_H__
+#define __FRAME_UNIFORMS_H__
+
+#include "common.h"
+
+/*
+** 모든 program이 공유하는 프레임 단위 uniform block
+  shader 쪽 선언 (lighting.vs/fs, simple.vs):
+    layout (std140) uniform FrameData {
+      mat4 view;
+      mat4 projection;
+      mat4 viewProjection;
+      vec3 viewPos;
+      Light light;
+    };
+  std140 규칙: vec3 / struct / mat4는 16 byte 단위로 정렬
+  -> C++ 구조체에도 alignas(16)을 붙여서 같은 메모리 배치를 만든다
+  Program::Link 시점에 shader의 실제 offset과 비교해서 어긋나면 링크 실패 처리
+*/
+#define FRAME_UNIFORM_BLOCK_NAME "FrameData"
+#define FRAME_UNIFORM_BINDING 0
+
+struct LightUniforms {
+  alignas(16) glm::vec3 position;
+  alignas(16) glm::vec3 ambient;
+  alignas(16) glm::vec3 diffuse;
+  alignas(16) glm::vec3 specular;
+};
+static_assert(sizeof(LightUniforms) == 64, "LightUniforms must follow std140 layout");
+
+struct FrameUniforms {
+  glm::mat4 view;
+  glm::mat4 projection;
+  glm::mat4 viewProjection;
+  alignas(16) glm::vec3 viewPos;
+  alignas(16) LightUniforms light;
+};
+static_assert(sizeof(FrameUniforms) == 272, "FrameUniforms must follow std140 layout");
+
+// program에 FrameData block이 있으면 C++ 구조체와 layout이 같은지 확인하고
+// FRAME_UNIFORM_BINDING에 연결한다. block이 없는 program은 그냥 통과
+bool BindFrameUniformBlock(uint32_t program);
+
+#endif // __FRAME_UNIFORMS_H__
@@ -0,0 +1,62 @@
+#include "framebuffer.h"
+
+FramebufferUPtr Framebuffer::Create(int width, int height) {
+  auto framebuffer = FramebufferUPtr(new Framebuffer());
+  if (!framebuffer->InitWithSize(width, height))
+    return nullptr;
+  return std::move(framebuffer);
+}
+
+void Framebuffer::BindToDefault() {
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+Framebuffer::~Framebuffer() {
+  if (m_depthStencilBuffer) {
+    glDeleteRenderbuffers(1, &m_depthStencilBuffer);
+  }
+  if (m_colorBuffer) {
+    glDeleteRenderbuffers(1, &m_colorBuffer);
+  }
+  if (m_framebuffer) {
+    glDeleteFramebuffers(1, &m_framebuffer);
+  }
+}
+
+void Framebuffer::Bind() const {
+  glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+}
+
+/*
+glGenRenderbuffers(): 샘플링할 필요가 없는 attachment용 renderbuffer 생성
+glRenderbufferStorage(): renderbuffer의 크기 및 픽셀 포맷 설정
+glFramebufferRenderbuffer(): framebuffer의 attachment 지점에 renderbuffer 연결
+glCheckFramebufferStatus(): attachment 구성이 렌더링 가능한 상태인지 확인
+*/
+bool Framebuffer::InitWithSize(int width, int height) {
+  m_width = width;
+  m_height = height;
+
+  glGenFramebuffers(1, &m_framebuffer);
+  Bind();
+
+  glGenRenderbuffers(1, &m_colorBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+    GL_RENDERBUFFER, m_colorBuffer);
+
+  glGenRenderbuffers(1, &m_depthStencilBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_depthStencilBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+    GL_RENDERBUFFER, m_depthStencilBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  auto result = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+  if (result != GL_FRAMEBUFFER_COMPLETE) {
+    SPDLOG_ERROR("failed to create framebuffer: 0x{:04x}", result);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,30 @@
+#ifndef __FRAMEBUFFER_H__
+#define __FRAMEBUFFER_H__
+
+#include "common.h"
+
+// 화면(default framebuffer) 대신 그림을 그릴 offscreen 렌더 타겟
+CLASS_PTR(Framebuffer)
+class Framebuffer {
+public:
+  static FramebufferUPtr Create(int width, int height);
+  static void BindToDefault();
+  ~Framebuffer();
+
+  uint32_t Get() const { return m_framebuffer; }
+  int GetWidth() const { return m_width; }
+  int GetHeight() const { return m_height; }
+  void Bind() const;
+
+private:
+  Framebuffer() {}
+  bool InitWithSize(int width, int height);
+
+  uint32_t m_framebuffer { 0 };
+  uint32_t m_colorBuffer { 0 };
+  uint32_t m_depthStencilBuffer { 0 };
+  int m_width { 0 };
+  int m_height { 0 };
+};
+
+#endif // __FRAMEBUFFER_H__
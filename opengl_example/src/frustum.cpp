@@ -0,0 +1,122 @@
+#include "frustum.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FRUSTUM_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SSE
+#endif
+
+/*
+Gribb-Hartmann 방식의 평면 추출
+  clip = M * p 일 때, 점이 frustum 안에 있으려면 -w <= x, y, z <= w
+  -> row3 ± row0 (left/right), row3 ± row1 (bottom/top), row3 ± row2 (near/far)
+  glm은 column-major이므로 i번째 row = (m[0][i], m[1][i], m[2][i], m[3][i])
+*/
+Frustum Frustum::FromMatrix(const glm::mat4& m) {
+  auto row = [&](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+  Frustum frustum;
+  frustum.planes[0] = row(3) + row(0);
+  frustum.planes[1] = row(3) - row(0);
+  frustum.planes[2] = row(3) + row(1);
+  frustum.planes[3] = row(3) - row(1);
+  frustum.planes[4] = row(3) + row(2);
+  frustum.planes[5] = row(3) - row(2);
+  for (auto& plane : frustum.planes)
+    plane /= glm::length(glm::vec3(plane));
+  return frustum;
+}
+
+// SIMD 경로와 같은 순서로 더하고 같은 비교를 해야 경계에 걸친 구의 판정이 폭과 상관없이 같음
+// (a * x + b * y) + (c * z + (d + r)) >= 0
+static bool IsSphereVisible(const Frustum& frustum,
+  float x, float y, float z, float radius) {
+  for (auto& plane : frustum.planes) {
+    float dist = (plane.x * x + plane.y * y) + (plane.z * z + (plane.w + radius));
+    if (!(dist >= 0.0f))
+      return false;
+  }
+  return true;
+}
+
+size_t CullSpheres(const Frustum& frustum,
+  const float* centerX, const float* centerY, const float* centerZ,
+  const float* radius, size_t count, uint32_t* visibleIndices) {
+
+  size_t visibleCount = 0;
+  size_t i = 0;
+
+#if defined(FRUSTUM_AVX2)
+  // 8개씩: 평면마다 dist + radius >= 0 인지 비교한 mask를 AND
+  __m256 planeA[6], planeB[6], planeC[6], planeD[6];
+  for (int p = 0; p < 6; p++) {
+    planeA[p] = _mm256_set1_ps(frustum.planes[p].x);
+    planeB[p] = _mm256_set1_ps(frustum.planes[p].y);
+    planeC[p] = _mm256_set1_ps(frustum.planes[p].z);
+    planeD[p] = _mm256_set1_ps(frustum.planes[p].w);
+  }
+  for (; i + 8 <= count; i += 8) {
+    __m256 x = _mm256_loadu_ps(centerX + i);
+    __m256 y = _mm256_loadu_ps(centerY + i);
+    __m256 z = _mm256_loadu_ps(centerZ + i);
+    __m256 r = _mm256_loadu_ps(radius + i);
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (int p = 0; p < 6; p++) {
+      __m256 dist = _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(planeA[p], x), _mm256_mul_ps(planeB[p], y)),
+        _mm256_add_ps(_mm256_mul_ps(planeC[p], z), _mm256_add_ps(planeD[p], r)));
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+    int mask = _mm256_movemask_ps(inside);
+    for (int bit = 0; bit < 8; bit++) {
+      if (mask & (1 << bit))
+        visibleIndices[visibleCount++] = (uint32_t)(i + bit);
+    }
+  }
+#elif defined(FRUSTUM_SSE)
+  // 4개씩
+  __m128 planeA[6], planeB[6], planeC[6], planeD[6];
+  for (int p = 0; p < 6; p++) {
+    planeA[p] = _mm_set1_ps(frustum.planes[p].x);
+    planeB[p] = _mm_set1_ps(frustum.planes[p].y);
+    planeC[p] = _mm_set1_ps(frustum.planes[p].z);
+    planeD[p] = _mm_set1_ps(frustum.planes[p].w);
+  }
+  for (; i + 4 <= count; i += 4) {
+    __m128 x = _mm_loadu_ps(centerX + i);
+    __m128 y = _mm_loadu_ps(centerY + i);
+    __m128 z = _mm_loadu_ps(centerZ + i);
+    __m128 r = _mm_loadu_ps(radius + i);
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int p = 0; p < 6; p++) {
+      __m128 dist = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(planeA[p], x), _mm_mul_ps(planeB[p], y)),
+        _mm_add_ps(_mm_mul_ps(planeC[p], z), _mm_add_ps(planeD[p], r)));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, _mm_setzero_ps()));
+    }
+    int mask = _mm_movemask_ps(inside);
+    for (int bit = 0; bit < 4; bit++) {
+      if (mask & (1 << bit))
+        visibleIndices[visibleCount++] = (uint32_t)(i + bit);
+    }
+  }
+#endif
+
+  // SIMD 폭으로 나누어 떨어지지 않는 나머지
+  for (; i < count; i++) {
+    if (IsSphereVisible(frustum, centerX[i], centerY[i], centerZ[i], radius[i]))
+      visibleIndices[visibleCount++] = (uint32_t)i;
+  }
+  return visibleCount;
+}
+
+const char* GetCullingImplementation() {
+#if defined(FRUSTUM_AVX2)
+  return "avx2";
+#elif defined(FRUSTUM_SSE)
+  return "sse";
+#else
+  return "scalar";
+#endif
+}
@@ -0,0 +1,29 @@
+#ifndef __FRUSTUM_H__
+#define __FRUSTUM_H__
+
+#include "common.h"
+
+/*
+** View frustum culling
+  projection * view 행렬에서 6개의 평면(left, right, bottom, top, near, far)을 뽑아
+  bounding sphere가 모든 평면의 안쪽(또는 걸쳐 있는지)에 있는지 검사한다
+  - SSE: 4개, AVX2: 8개의 sphere를 한 번에 검사 (컴파일 옵션에 따라 선택)
+  - 나머지 / SIMD를 쓸 수 없는 환경은 scalar 코드로 처리
+*/
+struct Frustum {
+  // (a, b, c, d): ax + by + cz + d >= 0 이면 평면 안쪽, (a, b, c)는 정규화됨
+  glm::vec4 planes[6];
+
+  static Frustum FromMatrix(const glm::mat4& viewProjection);
+};
+
+// sphere들이 SoA(center x/y/z, radius 배열)로 주어지면 보이는 sphere의 index를
+// visibleIndices에 기록하고 그 개수를 반환 (visibleIndices는 count개 이상 확보되어 있어야 함)
+size_t CullSpheres(const Frustum& frustum,
+  const float* centerX, const float* centerY, const float* centerZ,
+  const float* radius, size_t count, uint32_t* visibleIndices);
+
+// 빌드에 사용된 culling 구현 이름 ("avx2", "sse", "scalar")
+const char* GetCullingImplementation();
+
+#endif // __FRUSTUM_H__
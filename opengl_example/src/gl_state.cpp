@@ -0,0 +1,246 @@
+#include "gl_state.h"
+
+namespace {
+
+// 아직 모르는 상태 (Invalidate 직후): 어떤 값이 와도 GL을 호출한다
+constexpr uint32_t UNKNOWN = 0xFFFFFFFF;
+constexpr uint32_t TEXTURE_UNIT_COUNT = 16;
+constexpr uint32_t UNIFORM_BINDING_COUNT = 16;
+
+enum BufferTarget {
+  BUFFER_ARRAY,
+  BUFFER_ELEMENT_ARRAY,
+  BUFFER_UNIFORM,
+  BUFFER_PIXEL_UNPACK,
+  BUFFER_DRAW_INDIRECT,
+  BUFFER_TARGET_COUNT,
+};
+
+enum Capability {
+  CAP_DEPTH_TEST,
+  CAP_BLEND,
+  CAP_CULL_FACE,
+  CAP_SCISSOR_TEST,
+  CAP_STENCIL_TEST,
+  CAP_COUNT,
+};
+
+struct State {
+  uint32_t program { UNKNOWN };
+  uint32_t vertexArray { UNKNOWN };
+  uint32_t buffers[BUFFER_TARGET_COUNT];
+  uint32_t uniformBindings[UNIFORM_BINDING_COUNT];
+  uint32_t activeTextureUnit { UNKNOWN };
+  uint32_t textures[TEXTURE_UNIT_COUNT];
+  uint32_t capabilities[CAP_COUNT];
+
+  GLStateStats frameStats;
+  GLStateStats lastFrameStats;
+
+  State() { Invalidate(); }
+
+  void Invalidate() {
+    program = UNKNOWN;
+    vertexArray = UNKNOWN;
+    activeTextureUnit = UNKNOWN;
+    for (auto& buffer : buffers) buffer = UNKNOWN;
+    for (auto& binding : uniformBindings) binding = UNKNOWN;
+    for (auto& texture : textures) texture = UNKNOWN;
+    for (auto& capability : capabilities) capability = UNKNOWN;
+  }
+};
+
+State s_state;
+
+// -1: 아직 확인 전 (GL 함수 로딩 뒤 처음 물어볼 때 정함)
+int s_directStateAccess = -1;
+
+bool IsDirectStateAccessSupported() {
+  return GLAD_GL_VERSION_4_5 || GLAD_GL_ARB_direct_state_access;
+}
+
+int GetBufferTargetIndex(uint32_t target) {
+  switch (target) {
+    case GL_ARRAY_BUFFER: return BUFFER_ARRAY;
+    case GL_ELEMENT_ARRAY_BUFFER: return BUFFER_ELEMENT_ARRAY;
+    case GL_UNIFORM_BUFFER: return BUFFER_UNIFORM;
+    case GL_PIXEL_UNPACK_BUFFER: return BUFFER_PIXEL_UNPACK;
+    case GL_DRAW_INDIRECT_BUFFER: return BUFFER_DRAW_INDIRECT;
+    default: return -1;
+  }
+}
+
+int GetCapabilityIndex(uint32_t capability) {
+  switch (capability) {
+    case GL_DEPTH_TEST: return CAP_DEPTH_TEST;
+    case GL_BLEND: return CAP_BLEND;
+    case GL_CULL_FACE: return CAP_CULL_FACE;
+    case GL_SCISSOR_TEST: return CAP_SCISSOR_TEST;
+    case GL_STENCIL_TEST: return CAP_STENCIL_TEST;
+    default: return -1;
+  }
+}
+
+// cached 값이 value와 같으면 false (호출 생략), 다르면 갱신하고 true
+bool Update(uint32_t& cached, uint32_t value) {
+  if (cached == value) {
+    s_state.frameStats.elided++;
+    return false;
+  }
+  cached = value;
+  s_state.frameStats.issued++;
+  return true;
+}
+
+void SetCapability(uint32_t capability, bool enable) {
+  int index = GetCapabilityIndex(capability);
+  if (index < 0) {
+    s_state.frameStats.issued++;
+  }
+  else if (!Update(s_state.capabilities[index], enable ? 1 : 0)) {
+    return;
+  }
+  if (enable)
+    glEnable(capability);
+  else
+    glDisable(capability);
+}
+
+void SetActiveTextureUnit(uint32_t unit) {
+  if (Update(s_state.activeTextureUnit, unit))
+    glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+}
+
+void GLState::UseProgram(uint32_t program) {
+  if (Update(s_state.program, program))
+    glUseProgram(program);
+}
+
+/*
+GL_ELEMENT_ARRAY_BUFFER 바인딩은 VAO에 저장되는 상태
+  -> VAO가 바뀌면 어떤 index buffer가 바인딩되어 있는지 알 수 없다
+*/
+void GLState::BindVertexArray(uint32_t vertexArray) {
+  if (Update(s_state.vertexArray, vertexArray)) {
+    glBindVertexArray(vertexArray);
+    s_state.buffers[BUFFER_ELEMENT_ARRAY] = UNKNOWN;
+  }
+}
+
+void GLState::BindBuffer(uint32_t target, uint32_t buffer) {
+  int index = GetBufferTargetIndex(target);
+  if (index < 0) {
+    s_state.frameStats.issued++;
+  }
+  else if (!Update(s_state.buffers[index], buffer)) {
+    return;
+  }
+  glBindBuffer(target, buffer);
+}
+
+// glBindBufferBase()는 indexed binding과 함께 일반 binding point도 바꾼다
+void GLState::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) {
+  int targetIndex = GetBufferTargetIndex(target);
+  if (target == GL_UNIFORM_BUFFER && index < UNIFORM_BINDING_COUNT) {
+    if (!Update(s_state.uniformBindings[index], buffer))
+      return;
+  }
+  else {
+    s_state.frameStats.issued++;
+  }
+  glBindBufferBase(target, index, buffer);
+  if (targetIndex >= 0)
+    s_state.buffers[targetIndex] = buffer;
+}
+
+void GLState::BindTexture(uint32_t unit, uint32_t target, uint32_t texture) {
+  if (target != GL_TEXTURE_2D || unit >= TEXTURE_UNIT_COUNT) {
+    SetActiveTextureUnit(unit);
+    s_state.frameStats.issued++;
+    glBindTexture(target, texture);
+    return;
+  }
+  if (s_state.textures[unit] == texture) {
+    s_state.frameStats.elided++;
+    return;
+  }
+  SetActiveTextureUnit(unit);
+  Update(s_state.textures[unit], texture);
+  glBindTexture(target, texture);
+}
+
+void GLState::BindTexture(uint32_t target, uint32_t texture) {
+  auto unit = s_state.activeTextureUnit;
+  if (unit == UNKNOWN) {
+    // active unit을 모르면 0번으로 맞춘 뒤 바인딩
+    unit = 0;
+  }
+  BindTexture(unit, target, texture);
+}
+
+void GLState::Enable(uint32_t capability) {
+  SetCapability(capability, true);
+}
+
+void GLState::Disable(uint32_t capability) {
+  SetCapability(capability, false);
+}
+
+void GLState::Invalidate() {
+  s_state.Invalidate();
+}
+
+void GLState::ForgetProgram(uint32_t program) {
+  if (s_state.program == program)
+    s_state.program = UNKNOWN;
+}
+
+void GLState::ForgetVertexArray(uint32_t vertexArray) {
+  if (s_state.vertexArray == vertexArray) {
+    s_state.vertexArray = UNKNOWN;
+    s_state.buffers[BUFFER_ELEMENT_ARRAY] = UNKNOWN;
+  }
+}
+
+void GLState::ForgetBuffer(uint32_t buffer) {
+  for (auto& cached : s_state.buffers) {
+    if (cached == buffer)
+      cached = UNKNOWN;
+  }
+  for (auto& cached : s_state.uniformBindings) {
+    if (cached == buffer)
+      cached = UNKNOWN;
+  }
+}
+
+void GLState::ForgetTexture(uint32_t texture) {
+  for (auto& cached : s_state.textures) {
+    if (cached == texture)
+      cached = UNKNOWN;
+  }
+}
+
+bool GLState::HasDirectStateAccess() {
+  if (s_directStateAccess < 0)
+    s_directStateAccess = IsDirectStateAccessSupported() ? 1 : 0;
+  return s_directStateAccess > 0;
+}
+
+void GLState::SetDirectStateAccess(bool enable) {
+  s_directStateAccess = enable && IsDirectStateAccessSupported() ? 1 : 0;
+}
+
+void GLState::BeginFrame() {
+  s_state.lastFrameStats = s_state.frameStats;
+  s_state.frameStats = GLStateStats();
+}
+
+const GLStateStats& GLState::GetFrameStats() {
+  return s_state.frameStats;
+}
+
+const GLStateStats& GLState::GetLastFrameStats() {
+  return s_state.lastFrameStats;
+}
@@ -0,0 +1,54 @@
+#ifndef __GL_STATE_H__
+#define __GL_STATE_H__
+
+#include "common.h"
+
+/*
+** OpenGL state cache
+  지금 바인딩된 program, VAO, buffer, texture unit, enable bit를 기억해두고
+  바뀌지 않는 GL 호출은 건너뛴다 (driver 호출 / validation 비용 절약)
+  - GL context는 하나뿐이므로 static 함수로만 접근
+  - ImGui backend처럼 GL을 직접 건드리는 코드 다음에는 Invalidate()를 호출해야 한다
+  - 캐시에 없는 target / capability는 그대로 GL로 전달 (issued로 셈)
+*/
+struct GLStateStats {
+  uint32_t issued { 0 };
+  uint32_t elided { 0 };
+};
+
+class GLState {
+public:
+  static void UseProgram(uint32_t program);
+  static void BindVertexArray(uint32_t vertexArray);
+  static void BindBuffer(uint32_t target, uint32_t buffer);
+  static void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer);
+  // unit 번호는 0부터 (GL_TEXTURE0 + unit), 바인딩이 바뀔 때만 glActiveTexture 호출
+  static void BindTexture(uint32_t unit, uint32_t target, uint32_t texture);
+  // 지금 active unit에 바인딩 (texture 생성 / 파라미터 설정용)
+  static void BindTexture(uint32_t target, uint32_t texture);
+  static void Enable(uint32_t capability);
+  static void Disable(uint32_t capability);
+
+  // 캐시된 상태를 모두 "모름"으로 바꿔서 다음 호출은 반드시 GL로 전달되게 함
+  static void Invalidate();
+  // 삭제된 object의 이름은 재사용될 수 있으므로 캐시에서 지워야 한다
+  static void ForgetProgram(uint32_t program);
+  static void ForgetVertexArray(uint32_t vertexArray);
+  static void ForgetBuffer(uint32_t buffer);
+  static void ForgetTexture(uint32_t texture);
+
+  // GL 4.5 / ARB_direct_state_access: object 이름으로 바로 생성 / 수정 (바인딩을 바꾸지 않음)
+  // gladLoadGL() 뒤 처음 물어볼 때 지원 여부로 정해지고, SetDirectStateAccess(false)로 끌 수 있다
+  static bool HasDirectStateAccess();
+  static void SetDirectStateAccess(bool enable);
+
+  // 프레임 시작 시 호출: 지금까지의 카운트를 지난 프레임 통계로 옮기고 0으로 초기화
+  static void BeginFrame();
+  static const GLStateStats& GetFrameStats();
+  static const GLStateStats& GetLastFrameStats();
+
+private:
+  GLState() = delete;
+};
+
+#endif // __GL_STATE_H__
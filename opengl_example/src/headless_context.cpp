@@ -0,0 +1,85 @@
+#include "headless_context.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+HeadlessContextUPtr HeadlessContext::Create(int majorVersion, int minorVersion) {
+  auto context = HeadlessContextUPtr(new HeadlessContext());
+  if (!context->Init(majorVersion, minorVersion))
+    return nullptr;
+  return std::move(context);
+}
+
+void* HeadlessContext::GetProcAddress(const char* name) {
+  return (void*)eglGetProcAddress(name);
+}
+
+HeadlessContext::~HeadlessContext() {
+  if (m_display) {
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_context)
+      eglDestroyContext(m_display, m_context);
+    eglTerminate(m_display);
+  }
+}
+
+/*
+eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, ...):
+  X11/Wayland 없이 사용할 수 있는 display 획득
+eglCreateContext(): 원하는 버전/프로파일의 OpenGL context 생성
+eglMakeCurrent(EGL_NO_SURFACE): surface 없이 context만 활성화
+  -> 그림은 framebuffer object에 그린다
+*/
+bool HeadlessContext::Init(int majorVersion, int minorVersion) {
+  EGLDisplay display = EGL_NO_DISPLAY;
+  auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+    eglGetProcAddress("eglGetPlatformDisplayEXT");
+  if (getPlatformDisplay)
+    display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+  if (display == EGL_NO_DISPLAY)
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  if (display == EGL_NO_DISPLAY) {
+    SPDLOG_ERROR("failed to get egl display");
+    return false;
+  }
+
+  EGLint eglMajor = 0, eglMinor = 0;
+  if (!eglInitialize(display, &eglMajor, &eglMinor)) {
+    SPDLOG_ERROR("failed to initialize egl: 0x{:04x}", eglGetError());
+    return false;
+  }
+  m_display = display;
+  SPDLOG_INFO("EGL version: {}.{}", eglMajor, eglMinor);
+
+  if (!eglBindAPI(EGL_OPENGL_API)) {
+    SPDLOG_ERROR("failed to bind opengl api: 0x{:04x}", eglGetError());
+    return false;
+  }
+
+  // surfaceless display는 config가 없을 수 있다 -> EGL_KHR_no_config_context
+  EGLint configAttribs[] = {
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE,
+  };
+  EGLConfig config = EGL_NO_CONFIG_KHR;
+  EGLint configCount = 0;
+  if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0)
+    config = EGL_NO_CONFIG_KHR;
+
+  EGLint contextAttribs[] = {
+    EGL_CONTEXT_MAJOR_VERSION, majorVersion,
+    EGL_CONTEXT_MINOR_VERSION, minorVersion,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE,
+  };
+  m_context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+  if (!m_context) {
+    SPDLOG_ERROR("failed to create egl context: 0x{:04x}", eglGetError());
+    return false;
+  }
+
+  if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context)) {
+    SPDLOG_ERROR("failed to make egl context current: 0x{:04x}", eglGetError());
+    return false;
+  }
+  return true;
+}
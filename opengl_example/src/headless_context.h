@@ -0,0 +1,25 @@
+#ifndef __HEADLESS_CONTEXT_H__
+#define __HEADLESS_CONTEXT_H__
+
+#include "common.h"
+
+// 윈도우/디스플레이 없이 OpenGL context를 만들기 위한 EGL surfaceless context
+// (Mesa llvmpipe 같은 software renderer에서도 동작)
+CLASS_PTR(HeadlessContext)
+class HeadlessContext {
+public:
+  static HeadlessContextUPtr Create(int majorVersion, int minorVersion);
+  // gladLoadGLLoader()에 넘겨줄 함수 로더
+  static void* GetProcAddress(const char* name);
+  ~HeadlessContext();
+
+private:
+  HeadlessContext() {}
+  bool Init(int majorVersion, int minorVersion);
+
+  // EGL 헤더를 밖으로 노출하지 않기 위해 void*로 보관
+  void* m_display { nullptr };
+  void* m_context { nullptr };
+};
+
+#endif // __HEADLESS_CONTEXT_H__
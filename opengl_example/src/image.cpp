@@ -1,14 +1,57 @@
 #include "image.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
 ImageUPtr Image::Load(const std::string& filepath) {
+  auto file = MappedFile::Open(filepath);
+  if (!file)
+    return nullptr;
   auto image = ImageUPtr(new Image());
-  if (!image->LoadWithStb(filepath))
+  if (!image->LoadWithStb(file->GetData(), file->GetSize())) {
+    SPDLOG_ERROR("failed to load image: {} ({})", filepath, stbi_failure_reason());
     return nullptr;
+  }
   return std::move(image);
 }
 
+ImageUPtr Image::LoadFromMemory(const void* data, size_t size) {
+  auto image = ImageUPtr(new Image());
+  if (!image->LoadWithStb((const uint8_t*)data, size)) {
+    SPDLOG_ERROR("failed to decode image from memory: {}", stbi_failure_reason());
+    return nullptr;
+  }
+  return std::move(image);
+}
+
+// 파일마다 크기가 달라 미리 나누지 않고 thread가 다음 파일 번호를 하나씩 가져감
+std::vector<ImageUPtr> Image::LoadMany(const std::vector<std::string>& filepaths,
+  int threadCount) {
+  std::vector<ImageUPtr> images(filepaths.size());
+  if (threadCount <= 0)
+    threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+  size_t workerCount = std::min(filepaths.size(), (size_t)threadCount);
+
+  std::atomic<size_t> next { 0 };
+  auto worker = [&]() {
+    for (size_t i = next++; i < filepaths.size(); i = next++)
+      images[i] = Load(filepaths[i]);
+  };
+  std::vector<std::thread> threads;
+  if (workerCount > 1)
+    threads.reserve(workerCount - 1);
+  for (size_t i = 1; i < workerCount; i++)
+    threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads)
+    thread.join();
+  return images;
+}
+
 ImageUPtr Image::Create(int width, int height, int channelCount) {
   auto image = ImageUPtr(new Image());
   if (!image->Allocate(width, height, channelCount))
@@ -30,15 +73,20 @@ Image::~Image() {
   }
 }
 
-bool Image::LoadWithStb(const std::string& filepath) {
-  // 이미지 상하반전 해결
-  stbi_set_flip_vertically_on_load(true);
-  m_data = stbi_load(filepath.c_str(), &m_width, &m_height, &m_channelCount, 0);
-  if (!m_data) {
-    SPDLOG_ERROR("failed to load image: {}", filepath);
+size_t Image::GetMipChainSize() const {
+  size_t size = GetDataSize();
+  for (const auto& level : m_mipLevels)
+    size += level->GetDataSize();
+  return size;
+}
+
+bool Image::LoadWithStb(const uint8_t* data, size_t size) {
+  if (!data || size == 0 || size > INT_MAX)
     return false;
-  }
-  return true;
+  // 이미지 상하반전 해결 (이 thread에서만 적용되는 설정)
+  stbi_set_flip_vertically_on_load_thread(true);
+  m_data = stbi_load_from_memory(data, (int)size, &m_width, &m_height, &m_channelCount, 0);
+  return m_data != nullptr;
 }
 
 void Image::SetCheckImage(int gridX, int gridY) {
@@ -63,4 +111,12 @@ void Image::SetCheckImage(int gridX, int gridY) {
 // 1 1 1 1 0 0 0 0 .
 // 1 1 1 1 0 0 0 0   .
 // 1 1 1 1 0 0 0 0     .
-// 1 1 1 1 0 0 0 0       .
\ No newline at end of file
+// 1 1 1 1 0 0 0 0       .
+
+void Image::FlipVertical() {
+  size_t rowSize = (size_t)m_width * m_channelCount;
+  for (int j = 0; j < m_height / 2; j++) {
+    std::swap_ranges(m_data + j * rowSize, m_data + (j + 1) * rowSize,
+      m_data + (m_height - 1 - j) * rowSize);
+  }
+}
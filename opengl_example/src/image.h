@@ -2,29 +2,56 @@
 #define __IMAGE_H__
 
 #include "common.h"
+#include <vector>
 
+/*
+** Image decode (stb_image)
+  여러 thread에서 동시에 불러도 되도록 process 전역 상태를 쓰지 않음
+  - 상하반전 설정은 stbi_set_flip_vertically_on_load_thread()로 호출한 thread에만 적용
+  - 파일은 mmap 한 뒤 LoadFromMemory()로 decode (I/O를 직접 하는 쪽도 같은 경로 사용)
+*/
 CLASS_PTR(Image)
 class Image {
 public:
   static ImageUPtr Load(const std::string& filepath);
+  // 이미 메모리에 있는 파일 내용(jpg, png 등)을 decode, data는 호출하는 동안만 유효하면 됨
+  static ImageUPtr LoadFromMemory(const void* data, size_t size);
+  // filepaths를 threadCount개의 thread로 나눠서 decode (실패한 파일은 nullptr)
+  // threadCount가 0이면 hardware thread 수 사용
+  static std::vector<ImageUPtr> LoadMany(const std::vector<std::string>& filepaths,
+    int threadCount = 0);
   static ImageUPtr Create(int width, int height, int channelCount = 4);
   ~Image();
 
   const uint8_t* GetData() const { return m_data; }
+  uint8_t* GetData() { return m_data; }
   int GetWidth() const { return m_width; }
   int GetHeight() const { return m_height; }
   int GetChannelCount() const { return m_channelCount; }
+  size_t GetDataSize() const { return (size_t)m_width * m_height * m_channelCount; }
+
+  // mip level: 0은 이 image, 1 이상은 SetMipLevels()로 붙인 축소 image (MipmapGenerator)
+  int GetLevelCount() const { return 1 + (int)m_mipLevels.size(); }
+  const Image* GetLevel(int level) const {
+    return level == 0 ? this : m_mipLevels[level - 1].get();
+  }
+  void SetMipLevels(std::vector<ImageUPtr> mipLevels) { m_mipLevels = std::move(mipLevels); }
+  // 모든 level을 이어 붙인 byte 수
+  size_t GetMipChainSize() const;
 
   void SetCheckImage(int gridX, int gridY);
+  // 줄 순서를 위아래로 뒤집음 (level 0만, mip level은 그대로)
+  void FlipVertical();
 
 private:
   Image() {};
-  bool LoadWithStb(const std::string& filepath);
+  bool LoadWithStb(const uint8_t* data, size_t size);
   bool Allocate(int width, int height, int channelCount);
   int m_width { 0 };
   int m_height { 0 };
   int m_channelCount { 0 };
   uint8_t* m_data { nullptr };
+  std::vector<ImageUPtr> m_mipLevels;
 };
 
 #endif // __IMAGE_H__
\ No newline at end of file
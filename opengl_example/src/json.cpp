@@ -0,0 +1,246 @@
+#include "json.h"
+#include <charconv>
+#include <cstring>
+
+static const JsonValue s_nullValue;
+
+size_t JsonValue::GetSize() const {
+  if (m_type == Type::Array)
+    return m_array.size();
+  if (m_type == Type::Object)
+    return m_object.size();
+  return 0;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const {
+  if (m_type != Type::Array || index >= m_array.size())
+    return s_nullValue;
+  return m_array[index];
+}
+
+// glTF object의 key는 몇 개 안 되므로 선형 탐색
+const JsonValue& JsonValue::operator[](const char* key) const {
+  if (m_type != Type::Object)
+    return s_nullValue;
+  for (const auto& member : m_object) {
+    if (member.first == key)
+      return member.second;
+  }
+  return s_nullValue;
+}
+
+// 재귀 하강 parser: 실패하면 위치를 기록하고 false를 돌려줌
+class JsonParser {
+public:
+  JsonParser(const char* data, size_t size) : m_cur(data), m_begin(data), m_end(data + size) {}
+
+  bool ParseDocument(JsonValue& value) {
+    if (!ParseValue(value, 0))
+      return false;
+    SkipWhitespace();
+    return m_cur == m_end || Fail("unexpected trailing data");
+  }
+  size_t GetErrorOffset() const { return (size_t)(m_cur - m_begin); }
+  const char* GetError() const { return m_error; }
+
+private:
+  static constexpr int MAX_DEPTH = 256;
+
+  bool Fail(const char* error) {
+    m_error = error;
+    return false;
+  }
+
+  void SkipWhitespace() {
+    while (m_cur < m_end && (*m_cur == ' ' || *m_cur == '\t' || *m_cur == '\n' || *m_cur == '\r'))
+      m_cur++;
+  }
+
+  bool Match(const char* literal) {
+    size_t length = strlen(literal);
+    if ((size_t)(m_end - m_cur) < length || memcmp(m_cur, literal, length) != 0)
+      return false;
+    m_cur += length;
+    return true;
+  }
+
+  bool ParseValue(JsonValue& value, int depth) {
+    if (depth > MAX_DEPTH)
+      return Fail("nesting too deep");
+    SkipWhitespace();
+    if (m_cur == m_end)
+      return Fail("unexpected end of data");
+    switch (*m_cur) {
+      case '{': return ParseObject(value, depth);
+      case '[': return ParseArray(value, depth);
+      case '"':
+        value.m_type = JsonValue::Type::String;
+        return ParseString(value.m_string);
+      case 't':
+      case 'f':
+        value.m_type = JsonValue::Type::Bool;
+        value.m_bool = *m_cur == 't';
+        return Match(value.m_bool ? "true" : "false") || Fail("invalid literal");
+      case 'n':
+        value.m_type = JsonValue::Type::Null;
+        return Match("null") || Fail("invalid literal");
+      default:
+        return ParseNumber(value);
+    }
+  }
+
+  bool ParseNumber(JsonValue& value) {
+    // from_chars는 앞의 '+'를 받지 않지만 JSON 숫자에도 '+'는 없다
+    auto result = std::from_chars(m_cur, m_end, value.m_number);
+    if (result.ec != std::errc())
+      return Fail("invalid number");
+    value.m_type = JsonValue::Type::Number;
+    m_cur = result.ptr;
+    return true;
+  }
+
+  static void AppendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+      out += (char)codePoint;
+    }
+    else if (codePoint < 0x800) {
+      out += (char)(0xC0 | (codePoint >> 6));
+      out += (char)(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000) {
+      out += (char)(0xE0 | (codePoint >> 12));
+      out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+      out += (char)(0x80 | (codePoint & 0x3F));
+    }
+    else {
+      out += (char)(0xF0 | (codePoint >> 18));
+      out += (char)(0x80 | ((codePoint >> 12) & 0x3F));
+      out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+      out += (char)(0x80 | (codePoint & 0x3F));
+    }
+  }
+
+  bool ParseHex4(uint32_t& codePoint) {
+    if (m_end - m_cur < 4)
+      return Fail("invalid unicode escape");
+    auto result = std::from_chars(m_cur, m_cur + 4, codePoint, 16);
+    if (result.ec != std::errc() || result.ptr != m_cur + 4)
+      return Fail("invalid unicode escape");
+    m_cur += 4;
+    return true;
+  }
+
+  bool ParseString(std::string& out) {
+    m_cur++; // '"'
+    while (m_cur < m_end) {
+      char c = *m_cur++;
+      if (c == '"')
+        return true;
+      if (c != '\\') {
+        out += c;
+        continue;
+      }
+      if (m_cur == m_end)
+        break;
+      char escape = *m_cur++;
+      switch (escape) {
+        case '"': out += '"'; break;
+        case '\\': out += '\\'; break;
+        case '/': out += '/'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u': {
+          uint32_t codePoint = 0;
+          if (!ParseHex4(codePoint))
+            return false;
+          // surrogate pair
+          if (codePoint >= 0xD800 && codePoint < 0xDC00 && Match("\\u")) {
+            uint32_t low = 0;
+            if (!ParseHex4(low))
+              return false;
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+          }
+          AppendUtf8(out, codePoint);
+          break;
+        }
+        default:
+          return Fail("invalid escape");
+      }
+    }
+    return Fail("unterminated string");
+  }
+
+  bool ParseArray(JsonValue& value, int depth) {
+    value.m_type = JsonValue::Type::Array;
+    m_cur++; // '['
+    SkipWhitespace();
+    if (m_cur < m_end && *m_cur == ']') {
+      m_cur++;
+      return true;
+    }
+    while (true) {
+      value.m_array.emplace_back();
+      if (!ParseValue(value.m_array.back(), depth + 1))
+        return false;
+      SkipWhitespace();
+      if (m_cur == m_end)
+        return Fail("unterminated array");
+      char c = *m_cur++;
+      if (c == ']')
+        return true;
+      if (c != ',')
+        return Fail("expected ',' or ']'");
+    }
+  }
+
+  bool ParseObject(JsonValue& value, int depth) {
+    value.m_type = JsonValue::Type::Object;
+    m_cur++; // '{'
+    SkipWhitespace();
+    if (m_cur < m_end && *m_cur == '}') {
+      m_cur++;
+      return true;
+    }
+    while (true) {
+      SkipWhitespace();
+      if (m_cur == m_end || *m_cur != '"')
+        return Fail("expected key");
+      value.m_object.emplace_back();
+      auto& member = value.m_object.back();
+      if (!ParseString(member.first))
+        return false;
+      SkipWhitespace();
+      if (m_cur == m_end || *m_cur++ != ':')
+        return Fail("expected ':'");
+      if (!ParseValue(member.second, depth + 1))
+        return false;
+      SkipWhitespace();
+      if (m_cur == m_end)
+        return Fail("unterminated object");
+      char c = *m_cur++;
+      if (c == '}')
+        return true;
+      if (c != ',')
+        return Fail("expected ',' or '}'");
+    }
+  }
+
+  const char* m_cur;
+  const char* m_begin;
+  const char* m_end;
+  const char* m_error { nullptr };
+};
+
+std::optional<JsonValue> JsonValue::Parse(const char* data, size_t size) {
+  JsonValue value;
+  JsonParser parser(data, size);
+  if (!parser.ParseDocument(value)) {
+    SPDLOG_ERROR("failed to parse json at offset {}: {}",
+      parser.GetErrorOffset(), parser.GetError());
+    return {};
+  }
+  return value;
+}
@@ -0,0 +1,54 @@
+#ifndef __JSON_H__
+#define __JSON_H__
+
+#include "common.h"
+#include <vector>
+
+/*
+** 최소한의 JSON parser (glTF 읽기용)
+  - 숫자는 std::from_chars로 읽음 (locale, stream을 거치지 않음)
+  - 문자열의 \uXXXX escape는 UTF-8로 변환
+  - 찾는 key / index가 없으면 null 값을 돌려줘서 연쇄 접근이 안전함
+*/
+class JsonValue {
+public:
+  enum class Type { Null, Bool, Number, String, Array, Object };
+
+  static std::optional<JsonValue> Parse(const char* data, size_t size);
+
+  Type GetType() const { return m_type; }
+  bool IsNull() const { return m_type == Type::Null; }
+  bool IsNumber() const { return m_type == Type::Number; }
+  bool IsString() const { return m_type == Type::String; }
+  bool IsArray() const { return m_type == Type::Array; }
+  bool IsObject() const { return m_type == Type::Object; }
+
+  bool GetBool(bool defaultValue = false) const {
+    return m_type == Type::Bool ? m_bool : defaultValue;
+  }
+  double GetNumber(double defaultValue = 0.0) const {
+    return m_type == Type::Number ? m_number : defaultValue;
+  }
+  int64_t GetInt(int64_t defaultValue = 0) const {
+    return m_type == Type::Number ? (int64_t)m_number : defaultValue;
+  }
+  const std::string& GetString() const { return m_string; }
+
+  // array / object 원소 개수
+  size_t GetSize() const;
+  const JsonValue& operator[](size_t index) const;
+  const JsonValue& operator[](const char* key) const;
+  bool Has(const char* key) const { return !(*this)[key].IsNull(); }
+
+private:
+  friend class JsonParser;
+
+  Type m_type { Type::Null };
+  bool m_bool { false };
+  double m_number { 0.0 };
+  std::string m_string;
+  std::vector<JsonValue> m_array;
+  std::vector<std::pair<std::string, JsonValue>> m_object;
+};
+
+#endif // __JSON_H__
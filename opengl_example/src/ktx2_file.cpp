@@ -0,0 +1,130 @@
+#include "ktx2_file.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// VkFormat 값 (_SRGB도 같은 GL 형식: Image 경로처럼 sRGB texture 형식을 쓰지 않음)
+bool GetVkFormat(uint32_t vkFormat, TextureFormat& format) {
+  switch (vkFormat) {
+    case 9: // R8_UNORM
+      format = { GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1 };
+      return true;
+    case 16: // R8G8_UNORM
+      format = { GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2 };
+      return true;
+    case 23: case 29: // R8G8B8_UNORM / _SRGB
+      format = { GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, 3 };
+      return true;
+    case 37: case 43: // R8G8B8A8_UNORM / _SRGB
+      format = { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4 };
+      return true;
+    case 44: case 50: // B8G8R8A8_UNORM / _SRGB
+      format = { GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE, 4 };
+      return true;
+    case 131: case 132: // BC1_RGB_UNORM_BLOCK / _SRGB
+      format = { GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 0, 0, 8 };
+      return true;
+    case 133: case 134: // BC1_RGBA_UNORM_BLOCK / _SRGB
+      format = { GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 0, 0, 8 };
+      return true;
+    case 135: case 136: // BC2_UNORM_BLOCK / _SRGB
+      format = { GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 0, 0, 16 };
+      return true;
+    case 137: case 138: // BC3_UNORM_BLOCK / _SRGB
+      format = { GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 0, 0, 16 };
+      return true;
+    case 145: case 146: // BC7_UNORM_BLOCK / _SRGB
+      format = { GL_COMPRESSED_RGBA_BPTC_UNORM, 0, 0, 16 };
+      return true;
+    default:
+      return false;
+  }
+}
+
+/*
+key/value data: | byte 수 (uint32) | key\0value | 4byte 정렬 padding | ... 의 반복
+KTXorientation 값은 "rd\0"처럼 축마다 한 글자 (두 번째 글자가 y축: d = 위 줄부터, u = 아래 줄부터)
+key가 없으면 기본값 "rd"
+*/
+bool IsTopDown(const uint8_t* keyValueData, uint32_t size) {
+  static constexpr char ORIENTATION_KEY[] = "KTXorientation";
+  uint32_t offset = 0;
+  while (size - offset >= sizeof(uint32_t)) {
+    uint32_t length = 0;
+    memcpy(&length, keyValueData + offset, sizeof(length));
+    offset += sizeof(length);
+    if (length > size - offset)
+      break;
+    auto entry = (const char*)keyValueData + offset;
+    if (length > sizeof(ORIENTATION_KEY) + 1 &&
+      memcmp(entry, ORIENTATION_KEY, sizeof(ORIENTATION_KEY)) == 0)
+      return entry[sizeof(ORIENTATION_KEY) + 1] != 'u';
+    offset += std::min((length + 3) & ~3u, size - offset);
+  }
+  return true;
+}
+
+} // namespace
+
+bool Ktx2File::IsKtx2File(const uint8_t* data, size_t size) {
+  return size >= sizeof(Ktx2Header::IDENTIFIER) &&
+    memcmp(data, Ktx2Header::IDENTIFIER, sizeof(Ktx2Header::IDENTIFIER)) == 0;
+}
+
+bool Ktx2File::Parse(const std::string& filename, const uint8_t* data, size_t size,
+  TextureFormat& format, std::vector<TextureLevelData>& levels, bool& topDown) {
+  if (size < sizeof(Ktx2Header)) {
+    SPDLOG_ERROR("ktx2 file too small: {}", filename);
+    return false;
+  }
+  // mapping은 페이지 단위로 정렬되어 있으므로 header와 level index를 그대로 읽어도 된다
+  const auto& header = *(const Ktx2Header*)data;
+  if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth != 0 ||
+    header.layerCount != 0 || header.faceCount != 1 ||
+    header.pixelWidth > (1 << 16) || header.pixelHeight > (1 << 16)) {
+    SPDLOG_ERROR("ktx2 texture is not a single 2D texture ({}x{}x{}, {} layers, {} faces): {}",
+      header.pixelWidth, header.pixelHeight, header.pixelDepth, header.layerCount,
+      header.faceCount, filename);
+    return false;
+  }
+  if (header.supercompressionScheme != 0) {
+    SPDLOG_ERROR("ktx2 supercompression scheme {} not supported: {}",
+      header.supercompressionScheme, filename);
+    return false;
+  }
+  if (!GetVkFormat(header.vkFormat, format)) {
+    SPDLOG_ERROR("unsupported ktx2 vkFormat {}: {}", header.vkFormat, filename);
+    return false;
+  }
+
+  if (header.kvdByteOffset > size || header.kvdByteLength > size - header.kvdByteOffset) {
+    SPDLOG_ERROR("ktx2 key/value data out of file range: {}", filename);
+    return false;
+  }
+  topDown = IsTopDown(data + header.kvdByteOffset, header.kvdByteLength);
+
+  // levelCount 0은 "level 0만 있고 나머지는 만들어서 쓰라"는 뜻
+  uint32_t levelCount = std::max(header.levelCount, 1u);
+  if (levelCount > 32 ||
+    levelCount * sizeof(Ktx2LevelIndex) > size - sizeof(Ktx2Header)) {
+    SPDLOG_ERROR("invalid ktx2 level count {}: {}", header.levelCount, filename);
+    return false;
+  }
+  auto levelIndex = (const Ktx2LevelIndex*)(data + sizeof(Ktx2Header));
+  levels.clear();
+  for (uint32_t i = 0; i < levelCount; i++) {
+    const auto& index = levelIndex[i];
+    if (index.byteOffset > size || index.byteLength > size - index.byteOffset) {
+      SPDLOG_ERROR("ktx2 level {} out of file range: {}", i, filename);
+      return false;
+    }
+    TextureLevelData level;
+    level.width = std::max((int)header.pixelWidth >> i, 1);
+    level.height = std::max((int)header.pixelHeight >> i, 1);
+    level.data = data + index.byteOffset;
+    level.size = (size_t)index.byteLength;
+    levels.push_back(level);
+  }
+  return true;
+}
@@ -0,0 +1,57 @@
+#ifndef __KTX2_FILE_H__
+#define __KTX2_FILE_H__
+
+#include "common.h"
+#include "texture_file.h"
+
+/*
+** KTX2 (Khronos Texture 2.0) 파일
+  | Ktx2Header (identifier 포함) | level index (level마다 Ktx2LevelIndex) | DFD, key/value ... | level data |
+  - 형식은 vkFormat (Vulkan VkFormat 값)으로 지정 -> GL 형식으로 바꿔서 올림
+  - level index의 0번이 가장 큰 level (파일 안에서는 작은 level이 앞에 저장됨)
+  - key/value의 KTXorientation으로 줄 순서를 구분: "rd"(기본, 위 줄부터) / "ru"(아래 줄부터)
+  - supercompressionScheme이 0(압축 없음)인 파일만: Basis / zstd는 풀어야 해서 mapping을 그대로 쓸 수 없음
+  - 모든 값은 little endian
+*/
+struct Ktx2Header {
+  static constexpr uint8_t IDENTIFIER[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+  };
+
+  uint8_t identifier[12] {};
+  uint32_t vkFormat { 0 };
+  uint32_t typeSize { 0 };
+  uint32_t pixelWidth { 0 };
+  uint32_t pixelHeight { 0 };
+  uint32_t pixelDepth { 0 };
+  uint32_t layerCount { 0 };
+  uint32_t faceCount { 0 };
+  uint32_t levelCount { 0 };
+  uint32_t supercompressionScheme { 0 };
+  // 파일 처음부터의 byte offset
+  uint32_t dfdByteOffset { 0 };
+  uint32_t dfdByteLength { 0 };
+  uint32_t kvdByteOffset { 0 };
+  uint32_t kvdByteLength { 0 };
+  uint64_t sgdByteOffset { 0 };
+  uint64_t sgdByteLength { 0 };
+};
+static_assert(sizeof(Ktx2Header) == 80, "ktx2 header layout changed");
+
+struct Ktx2LevelIndex {
+  uint64_t byteOffset { 0 };
+  uint64_t byteLength { 0 };
+  uint64_t uncompressedByteLength { 0 };
+};
+static_assert(sizeof(Ktx2LevelIndex) == 24, "ktx2 level index layout changed");
+
+class Ktx2File {
+public:
+  static bool IsKtx2File(const uint8_t* data, size_t size);
+  // header를 확인하고 level마다 data 안의 위치를 채움 (filename은 에러 출력용)
+  // topDown: 위 줄부터 저장된 파일이면 true
+  static bool Parse(const std::string& filename, const uint8_t* data, size_t size,
+    TextureFormat& format, std::vector<TextureLevelData>& levels, bool& topDown);
+};
+
+#endif // __KTX2_FILE_H__
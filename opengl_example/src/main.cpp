@@ -1,10 +1,19 @@
 #include "context.h"
+#include "framebuffer.h"
+#include "benchmark.h"
+#include "gl_state.h"
+#include "profiler.h"
+#ifdef HEADLESS_EGL
+#include "headless_context.h"
+#endif
 
 #include <spdlog/spdlog.h>
 #include <glad/glad.h> // GLFW library 전에 include
 #include <GLFW/glfw3.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
+#include <fstream>
+#include <cstdlib>
 
 /*
   glViewport() : OpenGL이 그림을 그릴 화면의 위치 및 크기 설정
@@ -103,10 +112,266 @@ void OnScroll(GLFWwindow* window, double xoffset, double yoffset) {
   ImGui_ImplGlfw_ScrollCallback(window, xoffset, yoffset);
 }
 
+// 명령행 옵션
+//   --headless       : 윈도우 없이 EGL surfaceless context + framebuffer에 렌더링
+//   --bench N        : vsync를 끄고 N 프레임 렌더링 후 프레임 시간 통계를 JSON으로 출력
+//                      (cpu_ms / gpu_ms는 프레임 전체, geometry_gpu_ms는 장면 draw 구간의 GPU 시간)
+//   --bench-out FILE : JSON 리포트를 stdout 대신 파일에 한 줄씩 추가
+//   --profile-out FILE: 종료 시 scope 별 CPU/GPU 시간 기록을 JSON으로 저장
+//   --bench-uniform N: uniform 설정 경로 micro benchmark (N번 반복)
+//   --bench-import FILE: model(.obj / .gltf) 로딩 속도를 thread 수 별로 측정 (GL 없이 실행)
+//   --bench-image DIR: directory의 jpg / png decode 속도를 thread 수 별로 측정 (GL 없이 실행)
+//   --cubes N        : 그릴 큐브 개수 (1 ~ 100000)
+//   --no-instancing  : 큐브마다 draw call을 하나씩 사용
+//   --no-culling     : frustum culling 없이 모든 큐브를 그림
+//   --no-uniform-scale-shader : scale이 균일해도 CPU에서 계산한 normal matrix를 사용
+//   --no-multi-draw  : glMultiDrawElementsIndirect 대신 batch마다 draw call 사용
+//   --no-lod         : 거리와 상관없이 모든 object를 LOD 0(원본 mesh)으로 그림
+//   --no-dsa         : GL 4.5 direct state access 대신 bind 후 설정하는 기존 경로 사용
+struct Options {
+  bool headless { false };
+  bool instancing { true };
+  bool frustumCulling { true };
+  bool uniformScaleShader { true };
+  bool meshLod { true };
+  bool multiDrawIndirect { true };
+  bool directStateAccess { true };
+  int cubeCount { 10 };
+  int benchFrames { 0 };
+  int benchUniformIterations { 0 };
+  std::string benchOutput;
+  std::string profileOutput;
+  std::string benchImportFile;
+  std::string benchImageDirectory;
+};
+
+bool ParseOptions(int argc, const char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--headless") {
+      options.headless = true;
+    }
+    else if (arg == "--bench" && i + 1 < argc) {
+      options.benchFrames = std::atoi(argv[++i]);
+      if (options.benchFrames <= 0) {
+        SPDLOG_ERROR("invalid frame count: {}", argv[i]);
+        return false;
+      }
+    }
+    else if (arg == "--bench-uniform" && i + 1 < argc) {
+      options.benchUniformIterations = std::atoi(argv[++i]);
+      if (options.benchUniformIterations <= 0) {
+        SPDLOG_ERROR("invalid iteration count: {}", argv[i]);
+        return false;
+      }
+    }
+    else if (arg == "--bench-import" && i + 1 < argc) {
+      options.benchImportFile = argv[++i];
+    }
+    else if (arg == "--bench-image" && i + 1 < argc) {
+      options.benchImageDirectory = argv[++i];
+    }
+    else if (arg == "--cubes" && i + 1 < argc) {
+      options.cubeCount = std::atoi(argv[++i]);
+      if (options.cubeCount <= 0) {
+        SPDLOG_ERROR("invalid cube count: {}", argv[i]);
+        return false;
+      }
+    }
+    else if (arg == "--no-instancing") {
+      options.instancing = false;
+    }
+    else if (arg == "--no-culling") {
+      options.frustumCulling = false;
+    }
+    else if (arg == "--no-uniform-scale-shader") {
+      options.uniformScaleShader = false;
+    }
+    else if (arg == "--no-multi-draw") {
+      options.multiDrawIndirect = false;
+    }
+    else if (arg == "--no-lod") {
+      options.meshLod = false;
+    }
+    else if (arg == "--no-dsa") {
+      options.directStateAccess = false;
+    }
+    else if (arg == "--bench-out" && i + 1 < argc) {
+      options.benchOutput = argv[++i];
+    }
+    else if (arg == "--profile-out" && i + 1 < argc) {
+      options.profileOutput = argv[++i];
+    }
+    else {
+      SPDLOG_ERROR("unknown option: {}", arg);
+      return false;
+    }
+  }
+  return true;
+}
+
+void WriteBenchmarkReport(const std::string& json, const std::string& filename) {
+  if (filename.empty()) {
+    fmt::print("{}\n", json);
+    return;
+  }
+  std::ofstream fout(filename, std::ios::app);
+  if (!fout.is_open()) {
+    SPDLOG_ERROR("failed to open file: {}", filename);
+    return;
+  }
+  fout << json << std::endl;
+  SPDLOG_INFO("benchmark report saved: {}", filename);
+}
+
+void WriteProfileReport(const std::string& json, const std::string& filename) {
+  std::ofstream fout(filename);
+  if (!fout.is_open()) {
+    SPDLOG_ERROR("failed to open file: {}", filename);
+    return;
+  }
+  fout << json << std::endl;
+  SPDLOG_INFO("profile report saved: {}", filename);
+}
+
+#ifdef HEADLESS_EGL
+// headless 모드: GLFW 윈도우 대신 EGL context를 만들고 framebuffer에 그린다
+// 애니메이션 시간은 60FPS 간격으로 고정해서 매 실행마다 같은 장면을 그리도록 함
+int RunHeadless(const Options& options) {
+  SPDLOG_INFO("Create headless context");
+  auto headlessContext = HeadlessContext::Create(3, 3);
+  if (!headlessContext) {
+    SPDLOG_ERROR("failed to create headless context");
+    return -1;
+  }
+  if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::GetProcAddress)) {
+    SPDLOG_ERROR("failed to initialize glad");
+    return -1;
+  }
+  if (!options.directStateAccess)
+    GLState::SetDirectStateAccess(false);
+  SPDLOG_INFO("OpenGL context version: {}",
+    reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+  SPDLOG_INFO("OpenGL renderer: {}",
+    reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
+  auto framebuffer = Framebuffer::Create(WINDOW_WIDTH, WINDOW_HEIGHT);
+  if (!framebuffer)
+    return -1;
+
+  auto imguiContext = ImGui::CreateContext();
+  ImGui::SetCurrentContext(imguiContext);
+  auto& io = ImGui::GetIO();
+  io.IniFilename = nullptr;
+  io.DisplaySize = ImVec2((float)WINDOW_WIDTH, (float)WINDOW_HEIGHT);
+  io.DeltaTime = 1.0f / 60.0f;
+  ImGui_ImplOpenGL3_Init();
+  ImGui_ImplOpenGL3_CreateFontsTexture();
+  ImGui_ImplOpenGL3_CreateDeviceObjects();
+  // GLState를 거치지 않고 GL state를 바꾸는 코드 다음에는 캐시를 버려야 한다
+  GLState::Invalidate();
+
+  int frameCount = options.benchFrames > 0 ? options.benchFrames : 1;
+  auto benchmark = FrameBenchmark::Create(frameCount);
+  auto profiler = Profiler::Create();
+  auto context = Context::Create();
+  if (!context || !benchmark || !profiler) {
+    SPDLOG_ERROR("failed to create context");
+    ImGui::DestroyContext(imguiContext);
+    return -1;
+  }
+
+  // 매 실행마다 같은 장면을 그리도록 placeholder가 아닌 실제 texture로 시작
+  context->FinishTextureLoads();
+  framebuffer->Bind();
+  context->Reshape(WINDOW_WIDTH, WINDOW_HEIGHT);
+  context->SetProfiler(profiler.get());
+  context->SetBenchmark(benchmark.get());
+  context->SetCubeCount(options.cubeCount);
+  context->SetInstancing(options.instancing);
+  context->SetFrustumCulling(options.frustumCulling);
+  context->SetUniformScaleShader(options.uniformScaleShader);
+  context->SetMeshLod(options.meshLod);
+  context->SetMultiDrawIndirect(options.multiDrawIndirect);
+
+  if (options.benchUniformIterations > 0) {
+    WriteBenchmarkReport(RunUniformBenchmark(options.benchUniformIterations),
+      options.benchOutput);
+  }
+
+  SPDLOG_INFO("Start headless loop: {} frames", frameCount);
+  for (int frame = 0; !benchmark->IsDone(); frame++) {
+    benchmark->BeginFrame();
+    profiler->BeginFrame();
+    ImGui::NewFrame();
+
+    context->SetTime((float)frame / 60.0f);
+    {
+      ProfileScope scope(profiler.get(), "Render");
+      context->Render();
+    }
+    {
+      ProfileScope scope(profiler.get(), "ImGui::Render");
+      ImGui::Render();
+    }
+    {
+      ProfileScope scope(profiler.get(), "RenderDrawData");
+      // ImGui OpenGL3 backend는 자신이 바꾼 GL state를 그리기 후 복원하므로 캐시는 그대로 유효
+      ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+    {
+      // headless에는 swap할 화면이 없으므로 glFlush로 대신함
+      ProfileScope scope(profiler.get(), "SwapBuffers");
+      glFlush();
+    }
+    profiler->EndFrame();
+    benchmark->EndFrame();
+  }
+  benchmark->Finish();
+  profiler->Finish();
+  if (options.benchFrames > 0)
+    WriteBenchmarkReport(benchmark->ToJson(), options.benchOutput);
+  if (!options.profileOutput.empty())
+    WriteProfileReport(profiler->ToJson(), options.profileOutput);
+
+  context.reset();
+  profiler.reset();
+  benchmark.reset();
+  framebuffer.reset();
+
+  ImGui_ImplOpenGL3_DestroyFontsTexture();
+  ImGui_ImplOpenGL3_DestroyDeviceObjects();
+  ImGui_ImplOpenGL3_Shutdown();
+  ImGui::DestroyContext(imguiContext);
+  return 0;
+}
+#endif
 
 int main(int argc, const char** argv) {
   SPDLOG_INFO("Start Program");
 
+  Options options;
+  if (!ParseOptions(argc, argv, options))
+    return -1;
+
+  if (!options.benchImportFile.empty()) {
+    WriteBenchmarkReport(RunImportBenchmark(options.benchImportFile), options.benchOutput);
+    return 0;
+  }
+  if (!options.benchImageDirectory.empty()) {
+    WriteBenchmarkReport(RunImageBenchmark(options.benchImageDirectory), options.benchOutput);
+    return 0;
+  }
+
+  if (options.headless) {
+#ifdef HEADLESS_EGL
+    return RunHeadless(options);
+#else
+    SPDLOG_ERROR("headless mode is not available: built without EGL");
+    return -1;
+#endif
+  }
+
   // glfw 라이브러리 초기화, 실패하면 에러 출력 후 종료
   SPDLOG_INFO("Initialize glfw");
   if (!glfwInit()) {
@@ -136,6 +401,8 @@ int main(int argc, const char** argv) {
     glfwTerminate();
     return -1;
   }
+  if (!options.directStateAccess)
+    GLState::SetDirectStateAccess(false);
   auto glVersion = glGetString(GL_VERSION);
   // reinterpret_cast<const char*> : error 해결용
   SPDLOG_INFO("OpenGL context version: {}", reinterpret_cast<const char*>(glVersion));
@@ -146,6 +413,8 @@ int main(int argc, const char** argv) {
   ImGui_ImplOpenGL3_Init();
   ImGui_ImplOpenGL3_CreateFontsTexture();
   ImGui_ImplOpenGL3_CreateDeviceObjects();
+  // GLState를 거치지 않고 GL state를 바꾸는 코드 다음에는 캐시를 버려야 한다
+  GLState::Invalidate();
 
   auto context = Context::Create();
   if (!context) {
@@ -154,6 +423,14 @@ int main(int argc, const char** argv) {
     return -1;
   }
   glfwSetWindowUserPointer(window, context.get()); // glfw User Pointer
+  auto profiler = Profiler::Create();
+  context->SetProfiler(profiler.get());
+  context->SetCubeCount(options.cubeCount);
+  context->SetInstancing(options.instancing);
+  context->SetFrustumCulling(options.frustumCulling);
+  context->SetUniformScaleShader(options.uniformScaleShader);
+  context->SetMeshLod(options.meshLod);
+  context->SetMultiDrawIndirect(options.multiDrawIndirect);
 
   OnFrameBufferSizeChange(window, WINDOW_WIDTH, WINDOW_HEIGHT);
   glfwSetFramebufferSizeCallback(window, OnFrameBufferSizeChange);
@@ -164,22 +441,68 @@ int main(int argc, const char** argv) {
   glfwSetScrollCallback(window, OnScroll);
 
 
-  glfwSwapInterval(1); // Vsync 활성화 (60FPS로 맞추기)
+  // benchmark 중에는 vsync를 꺼서 실제 프레임 처리 시간을 측정
+  FrameBenchmarkUPtr benchmark;
+  if (options.benchFrames > 0) {
+    benchmark = FrameBenchmark::Create(options.benchFrames);
+    context->SetBenchmark(benchmark.get());
+    glfwSwapInterval(0);
+  }
+  else {
+    glfwSwapInterval(1); // Vsync 활성화 (60FPS로 맞추기)
+  }
   // glfw 루프 실행, 윈도우 close 버튼을 누르면 정상 종료
   SPDLOG_INFO("Start main loop");
   while (!glfwWindowShouldClose(window)) {
+    if (benchmark)
+      benchmark->BeginFrame();
+    profiler->BeginFrame();
     glfwPollEvents();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 
-    context->ProcessInput(window);
-    context->Render();
-    
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-    glfwSwapBuffers(window);
+    context->SetTime((float)glfwGetTime());
+    {
+      ProfileScope scope(profiler.get(), "ProcessInput");
+      context->ProcessInput(window);
+    }
+    {
+      ProfileScope scope(profiler.get(), "Render");
+      context->Render();
+    }
+    {
+      ProfileScope scope(profiler.get(), "ImGui::Render");
+      ImGui::Render();
+    }
+    {
+      ProfileScope scope(profiler.get(), "RenderDrawData");
+      // ImGui OpenGL3 backend는 자신이 바꾼 GL state를 그리기 후 복원하므로 캐시는 그대로 유효
+      ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+    {
+      ProfileScope scope(profiler.get(), "SwapBuffers");
+      glfwSwapBuffers(window);
+    }
+    profiler->EndFrame();
+
+    if (benchmark) {
+      benchmark->EndFrame();
+      if (benchmark->IsDone())
+        break;
+    }
+  }
+  if (benchmark) {
+    benchmark->Finish();
+    WriteBenchmarkReport(benchmark->ToJson(), options.benchOutput);
+    context->SetBenchmark(nullptr);
+    benchmark.reset();
+  }
+  if (!options.profileOutput.empty()) {
+    profiler->Finish();
+    WriteProfileReport(profiler->ToJson(), options.profileOutput);
   }
   context.reset();
+  profiler.reset();
 
   ImGui_ImplOpenGL3_DestroyFontsTexture();
   ImGui_ImplOpenGL3_DestroyDeviceObjects();
@@ -0,0 +1,89 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFileUPtr MappedFile::Open(const std::string& filename) {
+  auto file = MappedFileUPtr(new MappedFile());
+  if (!file->Init(filename))
+    return nullptr;
+  return std::move(file);
+}
+
+#ifdef _WIN32
+
+MappedFile::~MappedFile() {
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mapping)
+    CloseHandle(m_mapping);
+  if (m_file && m_file != INVALID_HANDLE_VALUE)
+    CloseHandle(m_file);
+}
+
+bool MappedFile::Init(const std::string& filename) {
+  m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (m_file == INVALID_HANDLE_VALUE) {
+    SPDLOG_ERROR("failed to open file: {}", filename);
+    return false;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+    SPDLOG_ERROR("failed to map empty file: {}", filename);
+    return false;
+  }
+  m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!m_mapping) {
+    SPDLOG_ERROR("failed to map file: {}", filename);
+    return false;
+  }
+  m_data = (const uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!m_data) {
+    SPDLOG_ERROR("failed to map file: {}", filename);
+    return false;
+  }
+  m_size = (size_t)size.QuadPart;
+  return true;
+}
+
+#else
+
+MappedFile::~MappedFile() {
+  if (m_data)
+    munmap((void*)m_data, m_size);
+}
+
+// mapping은 fd를 닫아도 유지되므로 fd는 바로 닫는다
+bool MappedFile::Init(const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    SPDLOG_ERROR("failed to open file: {}", filename);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    SPDLOG_ERROR("failed to map empty file: {}", filename);
+    close(fd);
+    return false;
+  }
+  void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    SPDLOG_ERROR("failed to map file: {}", filename);
+    return false;
+  }
+  m_data = (const uint8_t*)data;
+  m_size = (size_t)st.st_size;
+  return true;
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include "common.h"
+
+/*
+** Memory mapped file (읽기 전용)
+  파일을 통째로 읽어 복사하지 않고 OS가 페이지 단위로 필요할 때 읽어오도록 주소 공간에 연결
+  - POSIX: mmap(), Windows: CreateFileMapping() + MapViewOfFile()
+  - 객체가 살아 있는 동안만 GetData()가 유효
+*/
+CLASS_PTR(MappedFile)
+class MappedFile {
+public:
+  static MappedFileUPtr Open(const std::string& filename);
+  ~MappedFile();
+
+  const uint8_t* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+
+private:
+  MappedFile() {}
+  bool Init(const std::string& filename);
+
+  const uint8_t* m_data { nullptr };
+  size_t m_size { 0 };
+#ifdef _WIN32
+  void* m_file { nullptr };
+  void* m_mapping { nullptr };
+#endif
+};
+
+#endif // __MAPPED_FILE_H__
@@ -0,0 +1,91 @@
+#include "mesh_data.h"
+#include "mesh_file.h"
+#include "model_importer.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "vertex_compression.h"
+
+/*
+** Mesh converter (offline 도구)
+  mesh를 실행 파일이 바로 mmap 해서 쓸 수 있는 .mesh 형식으로 저장
+  사용법: mesh_converter [options] <input> <output.mesh>
+    - input: 내장 도형 이름 (cube) 또는 model 파일 (.obj, .gltf)
+    - 기본으로 LOD(삼각형 50%, 25%, 12%)를 만들어 같은 index data에 이어 붙임 (--no-lod: LOD 0만)
+    - 기본으로 MeshOptimizer를 거쳐 저장 (--no-optimize: 읽은 순서 그대로 저장)
+    - --compress: 16byte 압축 정점 (16bit position, 2 x 16bit octahedral normal, half uv)
+    - --compress8: 12byte 압축 정점 (normal만 2 x 8bit)
+*/
+static bool LoadInput(const std::string& input, MeshData& mesh) {
+  if (input == "cube") {
+    mesh = MeshData::CreateCube();
+    return true;
+  }
+  auto model = ModelImporter::Load(input);
+  if (!model)
+    return false;
+  mesh = std::move(*model);
+  return true;
+}
+
+int main(int argc, const char** argv) {
+  bool optimize = true;
+  bool generateLods = true;
+  std::optional<NormalEncoding> compression;
+  int argIndex = 1;
+  for (; argIndex < argc && argv[argIndex][0] == '-'; argIndex++) {
+    std::string option = argv[argIndex];
+    if (option == "--no-optimize")
+      optimize = false;
+    else if (option == "--no-lod")
+      generateLods = false;
+    else if (option == "--compress")
+      compression = NormalEncoding::Octahedral16;
+    else if (option == "--compress8")
+      compression = NormalEncoding::Octahedral8;
+    else
+      break;
+  }
+  if (argc - argIndex != 2) {
+    SPDLOG_ERROR("usage: {} [--no-optimize] [--no-lod] [--compress | --compress8] "
+      "<input> <output.mesh>", argv[0]);
+    return -1;
+  }
+  std::string input = argv[argIndex];
+  std::string output = argv[argIndex + 1];
+
+  MeshData mesh;
+  if (!LoadInput(input, mesh))
+    return -1;
+  // LOD는 원본 index로 만든 뒤 최적화에서 LOD 별로 삼각형 순서를 정리
+  if (generateLods) {
+    if (!MeshSimplifier::GenerateLods(mesh))
+      return -1;
+    for (size_t i = 1; i < mesh.lods.size(); i++) {
+      SPDLOG_INFO("LOD {}: {} triangles ({:.1f}%), error {:.5f}", i, mesh.lods[i].indexCount / 3,
+        100.0 * mesh.lods[i].indexCount / mesh.lods[0].indexCount, mesh.lods[i].error);
+    }
+  }
+  if (optimize) {
+    auto stats = MeshOptimizer::Optimize(mesh);
+    SPDLOG_INFO("optimized {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+      input, stats.before.acmr, stats.after.acmr, stats.before.atvr, stats.after.atvr);
+  }
+  // overdraw 최적화가 float position을 읽으므로 압축은 마지막에
+  if (compression) {
+    size_t floatSize = mesh.vertices.size();
+    if (!CompressVertices(mesh, *compression))
+      return -1;
+    SPDLOG_INFO("compressed vertices: {} -> {} bytes", floatSize, mesh.vertices.size());
+  }
+  if (!MeshFile::Write(output, mesh))
+    return -1;
+
+  // 쓴 파일을 다시 읽어서 header 검증까지 통과하는지 확인
+  auto meshFile = MeshFile::Load(output);
+  if (!meshFile)
+    return -1;
+  SPDLOG_INFO("wrote {}: {} vertices ({} bytes each), {} indices, {} attributes",
+    output, meshFile->GetVertexCount(), meshFile->GetVertexStride(),
+    meshFile->GetIndexCount(), meshFile->GetAttribCount());
+  return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef __MESH_DATA_H__
+#define __MESH_DATA_H__
+
+#include "common.h"
+#include "vertex_format.h"
+#include "mesh_lod.h"
+#include <vector>
+
+// 큐브와 model importer가 만드는 기본 정점 형식 (32byte)
+struct MeshVertex {
+  glm::vec3 position;
+  glm::vec3 normal;
+  glm::vec2 texCoord;
+};
+
+template <>
+struct VertexFormatOf<MeshVertex> {
+  static constexpr VertexFormat value = MakeVertexFormat<MeshVertex>(
+    VERTEX_ATTRIB(MeshVertex, position, 0),
+    VERTEX_ATTRIB(MeshVertex, normal, 1),
+    VERTEX_ATTRIB(MeshVertex, texCoord, 2));
+};
+static_assert(VertexFormatOf<MeshVertex>::value.stride == 32, "unexpected vertex padding");
+
+/*
+** CPU 쪽 mesh 데이터
+  정점은 GPU에 올라갈 byte 배열 그대로 (interleaved, vertexStride 간격)
+  인덱스는 32bit, 삼각형 목록
+  position이 양자화되어 있으면 shader에서 aPos * positionScale + positionOffset로 복원
+  (vertex_compression.h 참고, float position이면 1, 0)
+  LOD가 있으면 indices에 LOD 0, 1, ...의 index가 이어져 있고 lods가 각 범위를 가리킴
+  (비어 있으면 indices 전체가 LOD 0 하나)
+*/
+struct MeshData {
+  static constexpr uint32_t MAX_ATTRIB_COUNT = 8;
+
+  uint32_t vertexStride { 0 };
+  std::vector<MeshAttrib> attribs;
+  std::vector<uint8_t> vertices;
+  std::vector<uint32_t> indices;
+  std::vector<MeshLod> lods;
+  glm::vec3 positionScale { glm::vec3(1.0f) };
+  glm::vec3 positionOffset { glm::vec3(0.0f) };
+
+  uint32_t GetVertexCount() const {
+    return vertexStride ? (uint32_t)(vertices.size() / vertexStride) : 0;
+  }
+  VertexFormat GetVertexFormat() const {
+    return MakeVertexFormat(vertexStride, attribs.data(), (uint32_t)attribs.size());
+  }
+  // vertexStride / attribs를 format으로 바꿈 (정점 데이터는 건드리지 않음)
+  void SetVertexFormat(const VertexFormat& format);
+
+  // MeshVertex 배열로 정점 데이터와 layout을 채움
+  void SetVertices(const MeshVertex* meshVertices, size_t count);
+  // 한 변이 1인 큐브: 면마다 정점 4개
+  static MeshData CreateCube();
+};
+
+#endif // __MESH_DATA_H__
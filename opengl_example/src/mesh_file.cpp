@@ -0,0 +1,126 @@
+#include "mesh_file.h"
+#include <algorithm>
+#include <fstream>
+
+static constexpr uint64_t MESH_DATA_ALIGNMENT = 16;
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+MeshFileUPtr MeshFile::Load(const std::string& filename) {
+  auto meshFile = MeshFileUPtr(new MeshFile());
+  if (!meshFile->Init(filename))
+    return nullptr;
+  return std::move(meshFile);
+}
+
+// header 값을 믿기 전에 모든 범위가 파일 안에 있는지 확인
+bool MeshFile::Init(const std::string& filename) {
+  m_file = MappedFile::Open(filename);
+  if (!m_file)
+    return false;
+
+  uint64_t fileSize = m_file->GetSize();
+  if (fileSize < sizeof(MeshFileHeader)) {
+    SPDLOG_ERROR("mesh file too small: {}", filename);
+    return false;
+  }
+  // mapping은 페이지 단위로 정렬되어 있으므로 header를 그대로 읽어도 된다
+  m_header = (const MeshFileHeader*)m_file->GetData();
+  const auto& header = *m_header;
+  if (header.magic != MeshFileHeader::MAGIC || header.version != MeshFileHeader::VERSION) {
+    SPDLOG_ERROR("invalid mesh file (magic {:#x}, version {}): {}",
+      header.magic, header.version, filename);
+    return false;
+  }
+  if (header.vertexStride == 0 || header.attribCount == 0 ||
+    header.attribCount > MeshData::MAX_ATTRIB_COUNT) {
+    SPDLOG_ERROR("invalid mesh layout (stride {}, {} attribs): {}",
+      header.vertexStride, header.attribCount, filename);
+    return false;
+  }
+  for (uint32_t i = 0; i < header.attribCount; i++) {
+    const auto& attrib = header.attribs[i];
+    uint32_t attribSize = attrib.GetSize();
+    if (attribSize == 0 || attrib.offset >= header.vertexStride ||
+      attribSize > header.vertexStride - attrib.offset) {
+      SPDLOG_ERROR("invalid mesh attribute {} (type {:#x}, count {}, offset {}): {}",
+        i, attrib.type, attrib.count, attrib.offset, filename);
+      return false;
+    }
+  }
+  uint64_t vertexDataSize = (uint64_t)header.vertexStride * header.vertexCount;
+  uint64_t indexDataSize = (uint64_t)sizeof(uint32_t) * header.indexCount;
+  if (header.vertexDataOffset % MESH_DATA_ALIGNMENT != 0 ||
+    header.indexDataOffset % MESH_DATA_ALIGNMENT != 0 ||
+    header.vertexDataOffset < sizeof(MeshFileHeader) ||
+    header.vertexDataOffset > fileSize || vertexDataSize > fileSize - header.vertexDataOffset ||
+    header.indexDataOffset > fileSize || indexDataSize > fileSize - header.indexDataOffset) {
+    SPDLOG_ERROR("mesh data out of file range: {}", filename);
+    return false;
+  }
+  if (header.lodCount == 0 || header.lodCount > MeshLod::MAX_COUNT) {
+    SPDLOG_ERROR("invalid mesh LOD count {}: {}", header.lodCount, filename);
+    return false;
+  }
+  for (uint32_t i = 0; i < header.lodCount; i++) {
+    const auto& lod = header.lods[i];
+    if (lod.indexCount == 0 || lod.firstIndex > header.indexCount ||
+      lod.indexCount > header.indexCount - lod.firstIndex) {
+      SPDLOG_ERROR("mesh LOD {} out of index range: {}", i, filename);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MeshFile::Write(const std::string& filename, const MeshData& mesh) {
+  if (mesh.vertexStride == 0 || mesh.attribs.empty() ||
+    mesh.attribs.size() > MeshData::MAX_ATTRIB_COUNT ||
+    mesh.vertices.size() % mesh.vertexStride != 0 ||
+    mesh.lods.size() > MeshLod::MAX_COUNT) {
+    SPDLOG_ERROR("invalid mesh layout: {}", filename);
+    return false;
+  }
+
+  MeshFileHeader header;
+  header.vertexStride = mesh.vertexStride;
+  header.vertexCount = mesh.GetVertexCount();
+  header.indexCount = (uint32_t)mesh.indices.size();
+  header.attribCount = (uint32_t)mesh.attribs.size();
+  std::copy(mesh.attribs.begin(), mesh.attribs.end(), header.attribs);
+  header.vertexDataOffset = AlignUp(sizeof(MeshFileHeader), MESH_DATA_ALIGNMENT);
+  header.indexDataOffset = AlignUp(header.vertexDataOffset + mesh.vertices.size(),
+    MESH_DATA_ALIGNMENT);
+  for (int c = 0; c < 3; c++) {
+    header.positionScale[c] = mesh.positionScale[c];
+    header.positionOffset[c] = mesh.positionOffset[c];
+  }
+  // LOD를 만들지 않은 mesh는 index 전체가 LOD 0
+  if (mesh.lods.empty()) {
+    header.lodCount = 1;
+    header.lods[0].indexCount = header.indexCount;
+  }
+  else {
+    header.lodCount = (uint32_t)mesh.lods.size();
+    std::copy(mesh.lods.begin(), mesh.lods.end(), header.lods);
+  }
+
+  std::ofstream fout(filename, std::ios::binary);
+  if (!fout.is_open()) {
+    SPDLOG_ERROR("failed to open file: {}", filename);
+    return false;
+  }
+  const char padding[MESH_DATA_ALIGNMENT] = {};
+  fout.write((const char*)&header, sizeof(header));
+  fout.write(padding, header.vertexDataOffset - sizeof(header));
+  fout.write((const char*)mesh.vertices.data(), mesh.vertices.size());
+  fout.write(padding, header.indexDataOffset - header.vertexDataOffset - mesh.vertices.size());
+  fout.write((const char*)mesh.indices.data(), sizeof(uint32_t) * mesh.indices.size());
+  if (!fout) {
+    SPDLOG_ERROR("failed to write mesh file: {}", filename);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,77 @@
+#ifndef __MESH_FILE_H__
+#define __MESH_FILE_H__
+
+#include "common.h"
+#include "mesh_data.h"
+#include "mapped_file.h"
+
+/*
+** Binary mesh 파일 (.mesh)
+  GPU에 올릴 모양 그대로 저장해서 읽을 때 parsing / 변환 / 복사가 없다
+  - | header | vertex data (16byte 정렬) | index data (16byte 정렬) |
+  - header에 VertexLayout attribute 설명과 position 복원 값(scale, offset),
+    LOD 별 index 범위가 들어 있음 (LOD는 index data 안에 이어서 저장)
+  - 모든 값은 little endian
+  - 파일을 mmap 한 뒤 mapping된 주소를 그대로 glBufferSubData()에 넘긴다
+*/
+struct MeshFileHeader {
+  static constexpr uint32_t MAGIC = 0x4853454D; // "MESH"
+  static constexpr uint32_t VERSION = 3;
+
+  uint32_t magic { MAGIC };
+  uint32_t version { VERSION };
+  uint32_t vertexStride { 0 };
+  uint32_t vertexCount { 0 };
+  uint32_t indexCount { 0 };
+  uint32_t attribCount { 0 };
+  MeshAttrib attribs[MeshData::MAX_ATTRIB_COUNT] {};
+  // 파일 처음부터의 byte offset
+  uint64_t vertexDataOffset { 0 };
+  uint64_t indexDataOffset { 0 };
+  // version 2: 양자화된 position 복원 (position = aPos * scale + offset)
+  float positionScale[3] { 1.0f, 1.0f, 1.0f };
+  float positionOffset[3] { 0.0f, 0.0f, 0.0f };
+  // version 3: LOD 0(원본)부터 lodCount개의 index 범위
+  uint32_t lodCount { 0 };
+  uint32_t reserved { 0 };
+  MeshLod lods[MeshLod::MAX_COUNT] {};
+};
+static_assert(sizeof(MeshFileHeader) == 280, "mesh file header layout changed");
+
+CLASS_PTR(MeshFile)
+class MeshFile {
+public:
+  static MeshFileUPtr Load(const std::string& filename);
+  static bool Write(const std::string& filename, const MeshData& mesh);
+
+  const MeshFileHeader& GetHeader() const { return *m_header; }
+  uint32_t GetVertexStride() const { return m_header->vertexStride; }
+  uint32_t GetVertexCount() const { return m_header->vertexCount; }
+  uint32_t GetIndexCount() const { return m_header->indexCount; }
+  uint32_t GetAttribCount() const { return m_header->attribCount; }
+  const MeshAttrib* GetAttribs() const { return m_header->attribs; }
+  glm::vec3 GetPositionScale() const {
+    const float* scale = m_header->positionScale;
+    return glm::vec3(scale[0], scale[1], scale[2]);
+  }
+  glm::vec3 GetPositionOffset() const {
+    const float* offset = m_header->positionOffset;
+    return glm::vec3(offset[0], offset[1], offset[2]);
+  }
+  uint32_t GetLodCount() const { return m_header->lodCount; }
+  const MeshLod* GetLods() const { return m_header->lods; }
+  // mapping 안을 직접 가리킴 (MeshFile이 살아 있는 동안만 유효)
+  const void* GetVertexData() const { return m_file->GetData() + m_header->vertexDataOffset; }
+  const uint32_t* GetIndexData() const {
+    return (const uint32_t*)(m_file->GetData() + m_header->indexDataOffset);
+  }
+
+private:
+  MeshFile() {}
+  bool Init(const std::string& filename);
+
+  MappedFileUPtr m_file;
+  const MeshFileHeader* m_header { nullptr };
+};
+
+#endif // __MESH_FILE_H__
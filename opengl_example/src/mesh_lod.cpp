@@ -0,0 +1,14 @@
+#include "mesh_lod.h"
+
+float GetScreenSize(float radius, float depth, float projectionScale) {
+  return depth > radius ? radius * projectionScale / depth : 1.0f;
+}
+
+uint32_t SelectLod(float screenSize, uint32_t currentLod, uint32_t lodCount) {
+  uint32_t lod = currentLod < lodCount ? currentLod : 0;
+  while (lod + 1 < lodCount && screenSize < LOD_SCREEN_SIZES[lod] * (1.0f - LOD_HYSTERESIS))
+    lod++;
+  while (lod > 0 && screenSize > LOD_SCREEN_SIZES[lod - 1] * (1.0f + LOD_HYSTERESIS))
+    lod--;
+  return lod;
+}
@@ -0,0 +1,34 @@
+#ifndef __MESH_LOD_H__
+#define __MESH_LOD_H__
+
+#include "common.h"
+
+/*
+** Mesh LOD (level of detail)
+  - LOD 0이 원본, 그 뒤로 삼각형 수가 대략 50%, 25%, 12%인 단순화 mesh (MeshSimplifier)
+  - 모든 LOD가 같은 정점을 공유하고 index만 다름: index 배열에 LOD 0, 1, 2, ...를 이어 붙여 저장
+    -> LOD를 바꿔 그릴 때 firstIndex / indexCount만 바뀐다 (base vertex, VAO 그대로)
+  - 매 프레임 화면에 투영된 bounding sphere 크기로 LOD를 고름 (SelectLod)
+*/
+struct MeshLod {
+  static constexpr uint32_t MAX_COUNT = 4;
+
+  // mesh index 배열 안의 범위
+  uint32_t firstIndex { 0 };
+  uint32_t indexCount { 0 };
+  // 원본 표면에서 벗어난 거리의 추정치 (object space)
+  float error { 0.0f };
+};
+
+// LOD i -> i + 1로 내려가는 화면 크기 (bounding sphere 지름 / 화면 높이)
+static constexpr float LOD_SCREEN_SIZES[MeshLod::MAX_COUNT - 1] = { 0.25f, 0.125f, 0.0625f };
+// 경계 근처에서 LOD가 매 프레임 바뀌지 않도록 경계를 넘은 뒤 이 비율만큼 더 가야 바꿈
+static constexpr float LOD_HYSTERESIS = 0.1f;
+
+// 반지름 radius인 sphere가 view depth에서 화면 높이 중 차지하는 비율
+// (projectionScale = 1 / tan(fovy / 2), 카메라가 sphere 안에 있으면 화면을 다 덮는 것으로 봄)
+float GetScreenSize(float radius, float depth, float projectionScale);
+// 지난 프레임의 LOD에서 시작해서 경계를 여유 있게 넘었을 때만 한 단계씩 이동
+uint32_t SelectLod(float screenSize, uint32_t currentLod, uint32_t lodCount);
+
+#endif // __MESH_LOD_H__
@@ -0,0 +1,327 @@
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <cstring>
+
+static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+/*
+post-transform cache를 크기 cacheSize인 FIFO로 흉내 냄
+  - 정점마다 cache에 들어간 시각을 기록하고, 지금 시각과의 차이가 cacheSize 이하면 hit
+  - 시각을 cacheSize + 1만큼 건너뛰면 cache를 비운 것과 같다
+*/
+class VertexCacheSimulator {
+public:
+  VertexCacheSimulator(size_t vertexCount, uint32_t cacheSize)
+    : m_cacheSize(cacheSize), m_timestamp(cacheSize + 1), m_times(vertexCount, 0) {}
+
+  // miss면 cache에 넣고 true
+  bool Access(uint32_t vertex) {
+    if (m_timestamp - m_times[vertex] <= m_cacheSize)
+      return false;
+    m_times[vertex] = m_timestamp++;
+    return true;
+  }
+  uint32_t AccessTriangle(const uint32_t* triangle) {
+    return (uint32_t)Access(triangle[0]) + (uint32_t)Access(triangle[1]) +
+      (uint32_t)Access(triangle[2]);
+  }
+  void Flush() { m_timestamp += m_cacheSize + 1; }
+
+private:
+  uint32_t m_cacheSize;
+  uint32_t m_timestamp;
+  std::vector<uint32_t> m_times;
+};
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices,
+  size_t vertexCount, uint32_t cacheSize) {
+  VertexCacheStats stats;
+  size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0)
+    return stats;
+
+  VertexCacheSimulator cache(vertexCount, cacheSize);
+  std::vector<uint8_t> used(vertexCount, 0);
+  size_t usedCount = 0;
+  for (size_t i = 0; i < triangleCount * 3; i++) {
+    uint32_t vertex = indices[i];
+    stats.missCount += cache.Access(vertex) ? 1 : 0;
+    if (!used[vertex]) {
+      used[vertex] = 1;
+      usedCount++;
+    }
+  }
+  stats.acmr = (float)stats.missCount / (float)triangleCount;
+  stats.atvr = (float)stats.missCount / (float)usedCount;
+  return stats;
+}
+
+/*
+** Tipsify (Sander, Nehab, Barczak 2007)
+  정점 하나(fanning vertex)를 골라 그 정점을 쓰는 남은 삼각형을 모두 내보낸 뒤
+  방금 나온 정점 중 "아직 cache에 남아 있을 것 같고 남은 삼각형이 있는" 정점으로 이동
+  - 후보가 없으면(dead end) 최근에 나온 정점 stack, 그것도 없으면 앞에서부터 순서대로 찾음
+  - 정점 당 O(1)이라 전체가 선형 시간
+*/
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount,
+  uint32_t cacheSize) {
+  size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0)
+    return;
+
+  // 정점 별 인접 삼각형 목록 (CSR 형식)
+  std::vector<uint32_t> liveCounts(vertexCount, 0);
+  for (size_t i = 0; i < triangleCount * 3; i++)
+    liveCounts[indices[i]]++;
+  std::vector<uint32_t> offsets(vertexCount + 1, 0);
+  for (size_t v = 0; v < vertexCount; v++)
+    offsets[v + 1] = offsets[v] + liveCounts[v];
+  std::vector<uint32_t> adjacency(triangleCount * 3);
+  {
+    std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < triangleCount * 3; i++)
+      adjacency[cursors[indices[i]]++] = (uint32_t)(i / 3);
+  }
+
+  std::vector<uint32_t> cacheTimes(vertexCount, 0);
+  std::vector<uint8_t> emitted(triangleCount, 0);
+  std::vector<uint32_t> deadEnd;
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> result;
+  result.reserve(triangleCount * 3);
+  deadEnd.reserve(triangleCount * 3);
+  uint32_t timestamp = cacheSize + 1;
+  size_t cursor = 0;
+
+  int64_t fanning = 0;
+  while (fanning >= 0) {
+    candidates.clear();
+    for (uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; a++) {
+      uint32_t triangle = adjacency[a];
+      if (emitted[triangle])
+        continue;
+      emitted[triangle] = 1;
+      for (int k = 0; k < 3; k++) {
+        uint32_t vertex = indices[triangle * 3 + k];
+        result.push_back(vertex);
+        deadEnd.push_back(vertex);
+        candidates.push_back(vertex);
+        liveCounts[vertex]--;
+        if (timestamp - cacheTimes[vertex] > cacheSize)
+          cacheTimes[vertex] = timestamp++;
+      }
+    }
+
+    // 남은 삼각형을 다 내보내도 cache에 남아 있을 정점 중 가장 오래된 것을 우선
+    int64_t best = -1;
+    int64_t bestPriority = -1;
+    for (auto vertex : candidates) {
+      if (liveCounts[vertex] == 0)
+        continue;
+      int64_t priority = 0;
+      if (timestamp - cacheTimes[vertex] + 2 * liveCounts[vertex] <= cacheSize)
+        priority = timestamp - cacheTimes[vertex];
+      if (priority > bestPriority) {
+        best = vertex;
+        bestPriority = priority;
+      }
+    }
+    if (best < 0) {
+      while (!deadEnd.empty()) {
+        uint32_t vertex = deadEnd.back();
+        deadEnd.pop_back();
+        if (liveCounts[vertex] > 0) {
+          best = vertex;
+          break;
+        }
+      }
+    }
+    if (best < 0) {
+      while (cursor < vertexCount && liveCounts[cursor] == 0)
+        cursor++;
+      if (cursor < vertexCount)
+        best = (int64_t)cursor;
+    }
+    fanning = best;
+  }
+  std::copy(result.begin(), result.end(), indices.begin());
+}
+
+/*
+** Overdraw 최적화 (Sander et al. 2007)
+  - hard boundary: 세 정점이 모두 miss인 삼각형 (Tipsify가 dead end에서 새로 시작한 곳)
+  - soft boundary: hard cluster 안에서 지금까지의 ACMR이 cluster 전체 ACMR * threshold 이하로
+    내려오면 나눔 -> cluster 순서를 바꿔도 ACMR이 크게 나빠지지 않음
+  - cluster 정렬: dot(cluster 중심 - mesh 중심, cluster normal)이 큰 것(바깥을 향함)부터
+*/
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices,
+  const std::vector<glm::vec3>& positions, uint32_t cacheSize, float threshold) {
+  size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0)
+    return;
+
+  std::vector<size_t> hardBoundaries;
+  {
+    VertexCacheSimulator cache(positions.size(), cacheSize);
+    for (size_t t = 0; t < triangleCount; t++) {
+      if (cache.AccessTriangle(&indices[t * 3]) == 3 || t == 0)
+        hardBoundaries.push_back(t);
+    }
+  }
+  hardBoundaries.push_back(triangleCount);
+
+  std::vector<size_t> clusters;
+  VertexCacheSimulator cache(positions.size(), cacheSize);
+  for (size_t h = 0; h + 1 < hardBoundaries.size(); h++) {
+    size_t begin = hardBoundaries[h];
+    size_t end = hardBoundaries[h + 1];
+    cache.Flush();
+    size_t clusterMisses = 0;
+    for (size_t t = begin; t < end; t++)
+      clusterMisses += cache.AccessTriangle(&indices[t * 3]);
+    float target = threshold * (float)clusterMisses / (float)(end - begin);
+
+    cache.Flush();
+    clusters.push_back(begin);
+    size_t subBegin = begin;
+    size_t subMisses = 0;
+    for (size_t t = begin; t + 1 < end; t++) {
+      subMisses += cache.AccessTriangle(&indices[t * 3]);
+      if ((float)subMisses <= target * (float)(t - subBegin + 1)) {
+        cache.Flush();
+        clusters.push_back(t + 1);
+        subBegin = t + 1;
+        subMisses = 0;
+      }
+    }
+  }
+  clusters.push_back(triangleCount);
+  size_t clusterCount = clusters.size() - 1;
+
+  // 면적 가중 중심 / normal 합
+  std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+  std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+  glm::vec3 meshCentroid(0.0f);
+  float meshArea = 0.0f;
+  for (size_t c = 0; c < clusterCount; c++) {
+    float clusterArea = 0.0f;
+    for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+      const auto& p0 = positions[indices[t * 3 + 0]];
+      const auto& p1 = positions[indices[t * 3 + 1]];
+      const auto& p2 = positions[indices[t * 3 + 2]];
+      auto normal = glm::cross(p1 - p0, p2 - p0);
+      float area = glm::length(normal);
+      centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+      normals[c] += normal;
+      clusterArea += area;
+    }
+    meshCentroid += centroids[c];
+    meshArea += clusterArea;
+    centroids[c] = clusterArea > 0.0f ? centroids[c] / clusterArea : positions[indices[clusters[c] * 3]];
+  }
+  if (meshArea > 0.0f)
+    meshCentroid /= meshArea;
+
+  std::vector<float> sortKeys(clusterCount);
+  for (size_t c = 0; c < clusterCount; c++) {
+    float length = glm::length(normals[c]);
+    sortKeys[c] = length > 0.0f ?
+      glm::dot(centroids[c] - meshCentroid, normals[c] / length) : 0.0f;
+  }
+  std::vector<uint32_t> order(clusterCount);
+  for (size_t c = 0; c < clusterCount; c++)
+    order[c] = (uint32_t)c;
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return sortKeys[a] > sortKeys[b];
+  });
+
+  std::vector<uint32_t> result;
+  result.reserve(triangleCount * 3);
+  for (auto c : order) {
+    result.insert(result.end(), indices.begin() + clusters[c] * 3,
+      indices.begin() + clusters[c + 1] * 3);
+  }
+  std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeVertexFetch(MeshData& mesh) {
+  size_t vertexCount = mesh.GetVertexCount();
+  size_t stride = mesh.vertexStride;
+  std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+  std::vector<uint8_t> vertices;
+  vertices.reserve(mesh.vertices.size());
+  uint32_t nextVertex = 0;
+  for (auto& index : mesh.indices) {
+    if (remap[index] == INVALID_INDEX) {
+      remap[index] = nextVertex++;
+      vertices.insert(vertices.end(), mesh.vertices.begin() + index * stride,
+        mesh.vertices.begin() + (index + 1) * stride);
+    }
+    index = remap[index];
+  }
+  mesh.vertices = std::move(vertices);
+}
+
+bool MeshOptimizer::GetPositions(const MeshData& mesh, std::vector<glm::vec3>& positions) {
+  auto attrib = std::find_if(mesh.attribs.begin(), mesh.attribs.end(),
+    [](const MeshAttrib& attrib) { return attrib.attribIndex == 0; });
+  if (attrib == mesh.attribs.end() || attrib->type != GL_FLOAT || attrib->count < 3)
+    return false;
+  size_t vertexCount = mesh.GetVertexCount();
+  positions.resize(vertexCount);
+  for (size_t i = 0; i < vertexCount; i++)
+    memcpy(&positions[i], mesh.vertices.data() + i * mesh.vertexStride + attrib->offset,
+      sizeof(glm::vec3));
+  return true;
+}
+
+MeshOptimizer::Stats MeshOptimizer::Optimize(MeshData& mesh, uint32_t cacheSize,
+  float overdrawThreshold) {
+  Stats stats;
+  size_t vertexCount = mesh.GetVertexCount();
+  if (mesh.indices.size() % 3 != 0) {
+    SPDLOG_ERROR("mesh index count is not a multiple of 3: {}", mesh.indices.size());
+    return stats;
+  }
+  for (const auto& lod : mesh.lods) {
+    if (lod.firstIndex % 3 != 0 || lod.indexCount % 3 != 0 ||
+      lod.firstIndex > mesh.indices.size() ||
+      lod.indexCount > mesh.indices.size() - lod.firstIndex) {
+      SPDLOG_ERROR("mesh LOD out of index range: {} + {}", lod.firstIndex, lod.indexCount);
+      return stats;
+    }
+  }
+  for (auto index : mesh.indices) {
+    if (index >= vertexCount) {
+      SPDLOG_ERROR("mesh index out of range: {} >= {}", index, vertexCount);
+      return stats;
+    }
+  }
+
+  // LOD마다 따로 그려지므로 LOD 범위 안에서만 삼각형 순서를 바꿈 (stats는 LOD 0 기준)
+  std::vector<MeshLod> lods = mesh.lods;
+  if (lods.empty()) {
+    MeshLod lod;
+    lod.indexCount = (uint32_t)mesh.indices.size();
+    lods.push_back(lod);
+  }
+  std::vector<glm::vec3> positions;
+  bool hasPositions = GetPositions(mesh, positions);
+  if (!hasPositions)
+    SPDLOG_WARN("mesh has no float3 position: skipped overdraw optimization");
+  for (size_t i = 0; i < lods.size(); i++) {
+    auto begin = mesh.indices.begin() + lods[i].firstIndex;
+    std::vector<uint32_t> indices(begin, begin + lods[i].indexCount);
+    if (i == 0)
+      stats.before = AnalyzeVertexCache(indices, vertexCount, cacheSize);
+    OptimizeVertexCache(indices, vertexCount, cacheSize);
+    if (hasPositions)
+      OptimizeOverdraw(indices, positions, cacheSize, overdrawThreshold);
+    std::copy(indices.begin(), indices.end(), begin);
+  }
+  OptimizeVertexFetch(mesh);
+  std::vector<uint32_t> baseIndices(mesh.indices.begin() + lods[0].firstIndex,
+    mesh.indices.begin() + lods[0].firstIndex + lods[0].indexCount);
+  stats.after = AnalyzeVertexCache(baseIndices, mesh.GetVertexCount(), cacheSize);
+  return stats;
+}
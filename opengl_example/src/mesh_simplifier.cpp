@@ -0,0 +1,322 @@
+#include "mesh_simplifier.h"
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+/*
+평면들까지 거리 제곱의 합 = p^T A p + 2 b.p + c (A: 3x3 대칭 행렬)
+  - 삼각형 면적을 가중치로 더하고, 평가할 때 면적 합으로 나눠서 평균 거리 제곱으로 씀
+  - 값이 크게 상쇄되므로 double로 누적
+*/
+struct Quadric {
+  double a00 { 0.0 }, a01 { 0.0 }, a02 { 0.0 }, a11 { 0.0 }, a12 { 0.0 }, a22 { 0.0 };
+  double b0 { 0.0 }, b1 { 0.0 }, b2 { 0.0 };
+  double c { 0.0 };
+  double weight { 0.0 };
+
+  // 평면 n.p + d = 0 (n은 단위 벡터)
+  void AddPlane(double nx, double ny, double nz, double d, double w) {
+    a00 += w * nx * nx; a01 += w * nx * ny; a02 += w * nx * nz;
+    a11 += w * ny * ny; a12 += w * ny * nz; a22 += w * nz * nz;
+    b0 += w * nx * d; b1 += w * ny * d; b2 += w * nz * d;
+    c += w * d * d;
+    weight += w;
+  }
+  void Add(const Quadric& q) {
+    a00 += q.a00; a01 += q.a01; a02 += q.a02;
+    a11 += q.a11; a12 += q.a12; a22 += q.a22;
+    b0 += q.b0; b1 += q.b1; b2 += q.b2;
+    c += q.c;
+    weight += q.weight;
+  }
+  double Evaluate(const glm::vec3& p) const {
+    double x = p.x, y = p.y, z = p.z;
+    double value =
+      a00 * x * x + a11 * y * y + a22 * z * z +
+      2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+      2.0 * (b0 * x + b1 * y + b2 * z) + c;
+    return weight > 0.0 ? std::max(value, 0.0) / weight : 0.0;
+  }
+};
+
+// 정점(또는 group) 별 인접 삼각형 목록 (CSR 형식)
+struct TriangleAdjacency {
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> triangles;
+
+  // remap이 있으면 remap[index] 기준으로 모음
+  void Build(const std::vector<uint32_t>& indices, size_t vertexCount,
+    const uint32_t* remap = nullptr) {
+    offsets.assign(vertexCount + 1, 0);
+    for (auto index : indices)
+      offsets[(remap ? remap[index] : index) + 1]++;
+    for (size_t v = 0; v < vertexCount; v++)
+      offsets[v + 1] += offsets[v];
+    triangles.resize(indices.size());
+    std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++)
+      triangles[cursors[remap ? remap[indices[i]] : indices[i]]++] = (uint32_t)(i / 3);
+  }
+};
+
+// 같은 위치의 정점에 같은 group 번호를 매기고 group 별 정점 수를 돌려줌
+static std::vector<uint32_t> GroupVertices(const std::vector<glm::vec3>& positions,
+  std::vector<uint32_t>& groups) {
+  size_t vertexCount = positions.size();
+  std::vector<uint32_t> order(vertexCount);
+  for (size_t i = 0; i < vertexCount; i++)
+    order[i] = (uint32_t)i;
+  auto less = [&positions](uint32_t a, uint32_t b) {
+    const auto& pa = positions[a];
+    const auto& pb = positions[b];
+    if (pa.x != pb.x)
+      return pa.x < pb.x;
+    if (pa.y != pb.y)
+      return pa.y < pb.y;
+    return pa.z < pb.z;
+  };
+  std::sort(order.begin(), order.end(), less);
+
+  std::vector<uint32_t> groupSizes;
+  groups.resize(vertexCount);
+  for (size_t i = 0; i < vertexCount; i++) {
+    if (i == 0 || less(order[i - 1], order[i]))
+      groupSizes.push_back(0);
+    groups[order[i]] = (uint32_t)groupSizes.size() - 1;
+    groupSizes.back()++;
+  }
+  return groupSizes;
+}
+
+/*
+collapse를 여러 pass로 나눠서 실행
+  - 정점마다 가장 싼 collapse 대상(이웃 정점)을 고르고 비용 순으로 정렬
+  - 비용이 싼 것부터 접되, 이번 pass에서 접은 정점의 1-ring은 건드리지 않음
+    -> 같은 pass 안의 collapse끼리 서로의 판정(뒤집힘, 위상)에 영향을 주지 않는다
+  - pass가 끝나면 index를 다시 매기고 퇴화된 삼각형을 지움
+*/
+std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<uint32_t>& indices,
+  const std::vector<glm::vec3>& positions, size_t targetIndexCount, float* error) {
+  std::vector<uint32_t> result = indices;
+  if (error)
+    *error = 0.0f;
+  size_t vertexCount = positions.size();
+  if (result.size() <= targetIndexCount || vertexCount == 0)
+    return result;
+
+  std::vector<uint32_t> groups;
+  auto groupSizes = GroupVertices(positions, groups);
+  size_t groupCount = groupSizes.size();
+
+  std::vector<Quadric> quadrics(groupCount);
+  for (size_t i = 0; i + 2 < result.size(); i += 3) {
+    const auto& p0 = positions[result[i]];
+    const auto& p1 = positions[result[i + 1]];
+    const auto& p2 = positions[result[i + 2]];
+    auto normal = glm::cross(p1 - p0, p2 - p0);
+    float length = glm::length(normal);
+    if (length <= 0.0f)
+      continue;
+    normal /= length;
+    double d = -(double)glm::dot(normal, p0);
+    for (int k = 0; k < 3; k++)
+      quadrics[groups[result[i + k]]].AddPlane(normal.x, normal.y, normal.z, d, length * 0.5);
+  }
+
+  // seam 정점, 경계 / non-manifold edge의 정점은 고정
+  // (방향이 있는 edge a -> b의 반대 방향 b -> a를 가진 삼각형이 정확히 하나여야 내부 edge)
+  std::vector<uint8_t> locked(groupCount, 0);
+  for (size_t g = 0; g < groupCount; g++)
+    locked[g] = groupSizes[g] > 1 ? 1 : 0;
+  {
+    TriangleAdjacency groupAdjacency;
+    groupAdjacency.Build(result, groupCount, groups.data());
+    for (size_t t = 0; t < result.size() / 3; t++) {
+      for (int k = 0; k < 3; k++) {
+        uint32_t a = groups[result[t * 3 + k]];
+        uint32_t b = groups[result[t * 3 + (k + 1) % 3]];
+        uint32_t reverseCount = 0;
+        for (uint32_t i = groupAdjacency.offsets[b]; i < groupAdjacency.offsets[b + 1]; i++) {
+          const uint32_t* triangle = &result[groupAdjacency.triangles[i] * 3];
+          for (int j = 0; j < 3; j++) {
+            if (groups[triangle[j]] == b && groups[triangle[(j + 1) % 3]] == a)
+              reverseCount++;
+          }
+        }
+        if (reverseCount != 1)
+          locked[a] = locked[b] = 1;
+      }
+    }
+  }
+
+  TriangleAdjacency adjacency;
+  std::vector<double> bestCosts(vertexCount);
+  std::vector<uint32_t> bestTargets(vertexCount);
+  std::vector<uint32_t> remap(vertexCount);
+  std::vector<uint8_t> touched(vertexCount);
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> neighborsA;
+  std::vector<uint32_t> neighborsB;
+  std::vector<uint32_t> opposites;
+  double maxCost = 0.0;
+
+  // a -> b collapse 가능 여부: 남는 삼각형이 뒤집히지 않고, 공통 이웃이 a-b edge 양쪽 삼각형의
+  // 반대 정점뿐이어야 함 (link condition: 아니면 접은 뒤 edge를 셋 이상의 삼각형이 공유)
+  auto canCollapse = [&](uint32_t a, uint32_t b) {
+    const auto& pa = positions[a];
+    const auto& pb = positions[b];
+    neighborsA.clear();
+    opposites.clear();
+    for (uint32_t i = adjacency.offsets[a]; i < adjacency.offsets[a + 1]; i++) {
+      const uint32_t* triangle = &result[adjacency.triangles[i] * 3];
+      int k = triangle[0] == a ? 0 : (triangle[1] == a ? 1 : 2);
+      uint32_t v1 = triangle[(k + 1) % 3];
+      uint32_t v2 = triangle[(k + 2) % 3];
+      neighborsA.push_back(groups[v1]);
+      neighborsA.push_back(groups[v2]);
+      if (v1 == b || v2 == b) {
+        opposites.push_back(groups[v1 == b ? v2 : v1]);
+        continue;
+      }
+      const auto& p1 = positions[v1];
+      const auto& p2 = positions[v2];
+      auto before = glm::cross(p1 - pa, p2 - pa);
+      auto after = glm::cross(p1 - pb, p2 - pb);
+      if (glm::dot(before, after) <= 0.25f * glm::length(before) * glm::length(after))
+        return false;
+    }
+    neighborsB.clear();
+    for (uint32_t i = adjacency.offsets[b]; i < adjacency.offsets[b + 1]; i++) {
+      const uint32_t* triangle = &result[adjacency.triangles[i] * 3];
+      for (int k = 0; k < 3; k++)
+        neighborsB.push_back(groups[triangle[k]]);
+    }
+    for (auto* list : { &neighborsA, &neighborsB, &opposites }) {
+      std::sort(list->begin(), list->end());
+      list->erase(std::unique(list->begin(), list->end()), list->end());
+    }
+    size_t commonCount = 0;
+    for (auto group : neighborsA) {
+      if (group != groups[a] && group != groups[b] &&
+        std::binary_search(neighborsB.begin(), neighborsB.end(), group))
+        commonCount++;
+    }
+    return commonCount == opposites.size();
+  };
+
+  size_t targetTriangleCount = targetIndexCount / 3;
+  size_t triangleCount = result.size() / 3;
+  while (triangleCount > targetTriangleCount) {
+    adjacency.Build(result, vertexCount);
+
+    std::fill(bestTargets.begin(), bestTargets.end(), INVALID_INDEX);
+    for (size_t i = 0; i < result.size(); i++) {
+      uint32_t a = result[i];
+      if (locked[groups[a]])
+        continue;
+      size_t triangle = i / 3 * 3;
+      for (size_t k = 1; k < 3; k++) {
+        uint32_t b = result[triangle + (i - triangle + k) % 3];
+        Quadric quadric = quadrics[groups[a]];
+        quadric.Add(quadrics[groups[b]]);
+        double cost = quadric.Evaluate(positions[b]);
+        if (bestTargets[a] == INVALID_INDEX || cost < bestCosts[a]) {
+          bestTargets[a] = b;
+          bestCosts[a] = cost;
+        }
+      }
+    }
+    candidates.clear();
+    for (size_t v = 0; v < vertexCount; v++) {
+      if (bestTargets[v] != INVALID_INDEX)
+        candidates.push_back((uint32_t)v);
+    }
+    std::sort(candidates.begin(), candidates.end(), [&bestCosts](uint32_t a, uint32_t b) {
+      return bestCosts[a] < bestCosts[b];
+    });
+
+    // 내부 정점 하나를 접으면 삼각형이 2개 줄어듦
+    size_t collapseLimit = (triangleCount - targetTriangleCount + 1) / 2;
+    size_t collapseCount = 0;
+    std::fill(touched.begin(), touched.end(), 0);
+    for (size_t v = 0; v < vertexCount; v++)
+      remap[v] = (uint32_t)v;
+    for (auto a : candidates) {
+      if (collapseCount >= collapseLimit)
+        break;
+      uint32_t b = bestTargets[a];
+      if (touched[a] || touched[b] || !canCollapse(a, b))
+        continue;
+      remap[a] = b;
+      quadrics[groups[b]].Add(quadrics[groups[a]]);
+      maxCost = std::max(maxCost, bestCosts[a]);
+      for (uint32_t i = adjacency.offsets[a]; i < adjacency.offsets[a + 1]; i++) {
+        const uint32_t* triangle = &result[adjacency.triangles[i] * 3];
+        touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+      }
+      touched[b] = 1;
+      collapseCount++;
+    }
+    if (collapseCount == 0)
+      break;
+
+    size_t writeIndex = 0;
+    for (size_t i = 0; i < result.size(); i += 3) {
+      uint32_t v0 = remap[result[i]];
+      uint32_t v1 = remap[result[i + 1]];
+      uint32_t v2 = remap[result[i + 2]];
+      if (v0 == v1 || v1 == v2 || v2 == v0)
+        continue;
+      result[writeIndex++] = v0;
+      result[writeIndex++] = v1;
+      result[writeIndex++] = v2;
+    }
+    result.resize(writeIndex);
+    triangleCount = writeIndex / 3;
+  }
+
+  if (error)
+    *error = (float)std::sqrt(maxCost);
+  return result;
+}
+
+bool MeshSimplifier::GenerateLods(MeshData& mesh, const float* ratios, uint32_t ratioCount) {
+  // 이미 LOD가 있으면 LOD 0에서 다시 만듦
+  if (!mesh.lods.empty())
+    mesh.indices.resize(mesh.lods[0].firstIndex + mesh.lods[0].indexCount);
+  mesh.lods.clear();
+  MeshLod baseLod;
+  baseLod.indexCount = (uint32_t)mesh.indices.size();
+  mesh.lods.push_back(baseLod);
+
+  std::vector<glm::vec3> positions;
+  if (!MeshOptimizer::GetPositions(mesh, positions)) {
+    SPDLOG_ERROR("mesh has no float3 position: cannot generate LOD");
+    return false;
+  }
+
+  // 각 LOD는 바로 앞 LOD를 다시 줄여서 만듦 (원본에서 매번 시작하는 것보다 빠름)
+  size_t baseTriangleCount = mesh.indices.size() / 3;
+  std::vector<uint32_t> previous = mesh.indices;
+  float error = 0.0f;
+  for (uint32_t i = 0; i < ratioCount && mesh.lods.size() < MeshLod::MAX_COUNT; i++) {
+    size_t targetIndexCount = (size_t)((double)baseTriangleCount * ratios[i]) * 3;
+    float lodError = 0.0f;
+    auto lodIndices = Simplify(previous, positions, targetIndexCount, &lodError);
+    if (lodIndices.empty() ||
+      (float)lodIndices.size() > (float)previous.size() * MIN_LOD_REDUCTION)
+      break;
+    // 앞 LOD의 오차 위에 더해지므로 합으로 어림
+    error += lodError;
+    MeshLod lod;
+    lod.firstIndex = (uint32_t)mesh.indices.size();
+    lod.indexCount = (uint32_t)lodIndices.size();
+    lod.error = error;
+    mesh.lods.push_back(lod);
+    mesh.indices.insert(mesh.indices.end(), lodIndices.begin(), lodIndices.end());
+    previous = std::move(lodIndices);
+  }
+  return true;
+}
@@ -0,0 +1,36 @@
+#ifndef __MESH_SIMPLIFIER_H__
+#define __MESH_SIMPLIFIER_H__
+
+#include "common.h"
+#include "mesh_data.h"
+#include <vector>
+
+/*
+** Mesh simplifier (import / cook 단계에서 LOD 생성)
+  Quadric error metric (Garland, Heckbert 1997)으로 edge를 하나씩 접어서 삼각형 수를 줄임
+  - 정점 a를 이웃 정점 b 위치로 옮기는 collapse만 사용 -> 새 정점이 생기지 않아
+    모든 LOD가 원본 vertex buffer를 그대로 공유 (index만 새로 만듦)
+  - 비용: a, b에 모인 삼각형 평면들까지의 거리 제곱 합 (면적 가중 평균)
+  - 경계 edge, 같은 위치에 정점이 여러 개인 seam(normal / uv가 갈라지는 곳)의 정점은 고정
+    -> 외곽선, uv가 찢어지지 않음 (대신 모서리마다 정점이 나뉜 큐브 같은 mesh는 줄어들지 않음)
+  - 삼각형 면이 뒤집히거나 위상이 바뀌는(non-manifold) collapse는 건너뜀
+*/
+class MeshSimplifier {
+public:
+  // LOD 1, 2, 3의 목표 삼각형 비율 (원본 기준)
+  static constexpr float DEFAULT_LOD_RATIOS[MeshLod::MAX_COUNT - 1] = { 0.5f, 0.25f, 0.125f };
+  // 이전 LOD보다 삼각형이 이 비율 아래로 줄지 않으면 그 뒤 LOD는 만들지 않음
+  static constexpr float MIN_LOD_REDUCTION = 0.8f;
+
+  // targetIndexCount 이하가 될 때까지 (혹은 더 접을 edge가 없을 때까지) 단순화한 index 목록
+  // error: 단순화로 생긴 최대 거리 추정치
+  static std::vector<uint32_t> Simplify(const std::vector<uint32_t>& indices,
+    const std::vector<glm::vec3>& positions, size_t targetIndexCount, float* error = nullptr);
+
+  // mesh.indices(LOD 0) 뒤에 단순화한 LOD를 이어 붙이고 mesh.lods를 채움
+  // position은 attribute 0의 float3 (없으면 LOD 0만 남기고 false)
+  static bool GenerateLods(MeshData& mesh, const float* ratios = DEFAULT_LOD_RATIOS,
+    uint32_t ratioCount = MeshLod::MAX_COUNT - 1);
+};
+
+#endif // __MESH_SIMPLIFIER_H__
@@ -0,0 +1,356 @@
+#include "mipmap_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MIPMAP_AVX2
+#define MIPMAP_SSE
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIPMAP_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MIPMAP_NEON
+#endif
+
+namespace {
+
+// texel마다 float 4개 (channel이 4개보다 적으면 남는 lane은 0)
+struct FloatImage {
+  int width { 0 };
+  int height { 0 };
+  std::vector<float> texels;
+
+  void Resize(int w, int h) {
+    width = w;
+    height = h;
+    texels.assign((size_t)w * h * 4, 0.0f);
+  }
+  float* Row(int y) { return texels.data() + (size_t)y * width * 4; }
+  const float* Row(int y) const { return texels.data() + (size_t)y * width * 4; }
+};
+
+// texel 하나(float 4개)에 대한 연산
+#if defined(MIPMAP_SSE)
+using Vec4 = __m128;
+inline Vec4 Load4(const float* p) { return _mm_loadu_ps(p); }
+inline void Store4(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 Zero4() { return _mm_setzero_ps(); }
+inline Vec4 Add4(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+inline Vec4 Mul4(Vec4 a, float s) { return _mm_mul_ps(a, _mm_set1_ps(s)); }
+#elif defined(MIPMAP_NEON)
+using Vec4 = float32x4_t;
+inline Vec4 Load4(const float* p) { return vld1q_f32(p); }
+inline void Store4(float* p, Vec4 v) { vst1q_f32(p, v); }
+inline Vec4 Zero4() { return vdupq_n_f32(0.0f); }
+inline Vec4 Add4(Vec4 a, Vec4 b) { return vaddq_f32(a, b); }
+inline Vec4 Mul4(Vec4 a, float s) { return vmulq_n_f32(a, s); }
+#else
+struct Vec4 {
+  float v[4];
+};
+inline Vec4 Load4(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void Store4(float* p, Vec4 a) { std::copy(a.v, a.v + 4, p); }
+inline Vec4 Zero4() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+inline Vec4 Add4(Vec4 a, Vec4 b) {
+  return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+}
+inline Vec4 Mul4(Vec4 a, float s) {
+  return { { a.v[0] * s, a.v[1] * s, a.v[2] * s, a.v[3] * s } };
+}
+#endif
+
+/*
+sRGB <-> linear 변환표
+  - decode: 8bit 값 256개를 미리 계산
+  - encode: 인접한 두 8bit 값의 중간점(sRGB 기준)을 linear로 바꾼 255개의 경계
+    -> 이진 탐색으로 sRGB 공간에서 가장 가까운 8bit 값을 고름 (pow() 없이 정확한 반올림)
+*/
+float SrgbToLinear(float c) {
+  return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+struct SrgbTables {
+  float toLinear[256];
+  float encodeThresholds[255];
+
+  SrgbTables() {
+    for (int i = 0; i < 256; i++)
+      toLinear[i] = SrgbToLinear(i / 255.0f);
+    for (int i = 0; i < 255; i++)
+      encodeThresholds[i] = SrgbToLinear((i + 0.5f) / 255.0f);
+  }
+};
+
+const SrgbTables& GetSrgbTables() {
+  static const SrgbTables tables;
+  return tables;
+}
+
+uint8_t LinearToSrgb8(const SrgbTables& tables, float value) {
+  const float* thresholds = tables.encodeThresholds;
+  return (uint8_t)(std::upper_bound(thresholds, thresholds + 255, value) - thresholds);
+}
+
+uint8_t LinearToUnorm8(float value) {
+  return (uint8_t)(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// channel 별 처리 방법 (1: R, 2: R + alpha, 3: RGB, 4: RGB + alpha)
+struct ChannelLayout {
+  int channelCount { 0 };
+  int alphaLane { -1 };
+  bool srgb[4] {};
+
+  ChannelLayout(int count, bool srgbColor) : channelCount(count) {
+    if (count == 2 || count == 4)
+      alphaLane = count - 1;
+    for (int k = 0; k < count; k++)
+      srgb[k] = srgbColor && k != alphaLane;
+  }
+};
+
+void Decode(const Image* image, const ChannelLayout& layout, FloatImage& result) {
+  const auto& tables = GetSrgbTables();
+  result.Resize(image->GetWidth(), image->GetHeight());
+  const uint8_t* src = image->GetData();
+  float* dst = result.texels.data();
+  size_t texelCount = (size_t)result.width * result.height;
+  int channelCount = layout.channelCount;
+  for (size_t i = 0; i < texelCount; i++) {
+    for (int k = 0; k < channelCount; k++) {
+      uint8_t value = src[i * channelCount + k];
+      dst[i * 4 + k] = layout.srgb[k] ? tables.toLinear[value] : value / 255.0f;
+    }
+  }
+}
+
+void Encode(const FloatImage& source, const ChannelLayout& layout, float alphaScale,
+  Image* image) {
+  const auto& tables = GetSrgbTables();
+  const float* src = source.texels.data();
+  uint8_t* dst = image->GetData();
+  size_t texelCount = (size_t)source.width * source.height;
+  int channelCount = layout.channelCount;
+  for (size_t i = 0; i < texelCount; i++) {
+    for (int k = 0; k < channelCount; k++) {
+      float value = src[i * 4 + k];
+      if (k == layout.alphaLane)
+        value *= alphaScale;
+      dst[i * channelCount + k] = layout.srgb[k] ?
+        LinearToSrgb8(tables, value) : LinearToUnorm8(value);
+    }
+  }
+}
+
+// 2x2 평균, 줄 끝(홀수 크기, 1 texel 폭)은 가장자리 texel을 반복
+void DownsampleBox(const FloatImage& src, FloatImage& dst) {
+  for (int y = 0; y < dst.height; y++) {
+    const float* row0 = src.Row(std::min(2 * y, src.height - 1));
+    const float* row1 = src.Row(std::min(2 * y + 1, src.height - 1));
+    float* out = dst.Row(y);
+    int x = 0;
+#if defined(MIPMAP_AVX2)
+    // 출력 texel 2개씩: 입력 (p0, p1), (p2, p3)를 더한 뒤 128bit 단위로 섞어서 (p0 + p1, p2 + p3)
+    if (src.width >= 2) {
+      const __m256 quarter = _mm256_set1_ps(0.25f);
+      for (; x + 2 <= dst.width; x += 2) {
+        __m256 a = _mm256_add_ps(_mm256_loadu_ps(row0 + 8 * x), _mm256_loadu_ps(row1 + 8 * x));
+        __m256 b = _mm256_add_ps(_mm256_loadu_ps(row0 + 8 * x + 8),
+          _mm256_loadu_ps(row1 + 8 * x + 8));
+        __m256 even = _mm256_permute2f128_ps(a, b, 0x20);
+        __m256 odd = _mm256_permute2f128_ps(a, b, 0x31);
+        _mm256_storeu_ps(out + 4 * x, _mm256_mul_ps(_mm256_add_ps(even, odd), quarter));
+      }
+    }
+#endif
+    for (; x < dst.width; x++) {
+      int x0 = std::min(2 * x, src.width - 1) * 4;
+      int x1 = std::min(2 * x + 1, src.width - 1) * 4;
+      Vec4 sum = Add4(Add4(Load4(row0 + x0), Load4(row0 + x1)),
+        Add4(Load4(row1 + x0), Load4(row1 + x1)));
+      Store4(out + 4 * x, Mul4(sum, 0.25f));
+    }
+  }
+}
+
+/*
+Kaiser-windowed sinc (2x 축소)
+  출력 texel 중심은 입력 2x + 0.5 위치, 양쪽 3 texel씩 6개를 읽음
+  weight = sinc(d / 2) * kaiser(d / 3), d = 입력 texel 중심까지 거리 (beta = 4)
+  가로로 먼저 줄인 뒤 세로로 줄임 (separable), 가장자리 밖은 clamp
+*/
+constexpr int KAISER_TAP_COUNT = 6;
+
+double BesselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 32; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+struct KaiserWeights {
+  float weights[KAISER_TAP_COUNT];
+
+  KaiserWeights() {
+    const double pi = 3.14159265358979323846;
+    const double beta = 4.0;
+    double total = 0.0;
+    double values[KAISER_TAP_COUNT];
+    for (int i = 0; i < KAISER_TAP_COUNT; i++) {
+      double d = i - 2.5;
+      double t = d / 2.0;
+      double sinc = std::sin(pi * t) / (pi * t);
+      double r = d / 3.0;
+      double window = BesselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / BesselI0(beta);
+      values[i] = sinc * window;
+      total += values[i];
+    }
+    for (int i = 0; i < KAISER_TAP_COUNT; i++)
+      weights[i] = (float)(values[i] / total);
+  }
+};
+
+const KaiserWeights& GetKaiserWeights() {
+  static const KaiserWeights weights;
+  return weights;
+}
+
+void DownsampleKaiser(const FloatImage& src, FloatImage& dst, FloatImage& temp) {
+  const float* weights = GetKaiserWeights().weights;
+  temp.Resize(dst.width, src.height);
+  for (int y = 0; y < src.height; y++) {
+    const float* in = src.Row(y);
+    float* out = temp.Row(y);
+    for (int x = 0; x < dst.width; x++) {
+      Vec4 sum = Zero4();
+      for (int i = 0; i < KAISER_TAP_COUNT; i++) {
+        int sx = std::clamp(2 * x - 2 + i, 0, src.width - 1);
+        sum = Add4(sum, Mul4(Load4(in + 4 * sx), weights[i]));
+      }
+      Store4(out + 4 * x, sum);
+    }
+  }
+  // 세로: 한 줄 전체에 같은 weight를 곱해 더함 (연속된 메모리를 그대로 읽음)
+  size_t rowFloats = (size_t)dst.width * 4;
+  for (int y = 0; y < dst.height; y++) {
+    float* out = dst.Row(y);
+    std::fill(out, out + rowFloats, 0.0f);
+    for (int i = 0; i < KAISER_TAP_COUNT; i++) {
+      const float* in = temp.Row(std::clamp(2 * y - 2 + i, 0, src.height - 1));
+      for (size_t j = 0; j < rowFloats; j += 4)
+        Store4(out + j, Add4(Load4(out + j), Mul4(Load4(in + j), weights[i])));
+    }
+  }
+}
+
+/*
+alpha coverage 보존 (Castaño, "Computing Alpha Mipmaps")
+  level 0에서 alpha >= cutoff인 비율 coverage를 구하고, 각 level에서 alpha 값이 큰 순서로
+  coverage 비율째인 값이 cutoff가 되도록 alpha 전체에 곱할 scale을 찾음
+  같은 alpha 값이 많으면(축소된 단색 영역 등) 그 값을 통과시키는 경우와 떨어뜨리는 경우 중
+  목표 비율에 더 가까운 쪽을 고름
+*/
+float ComputeCoverage(const FloatImage& image, int alphaLane, float cutoff) {
+  size_t texelCount = (size_t)image.width * image.height;
+  size_t covered = 0;
+  for (size_t i = 0; i < texelCount; i++)
+    covered += image.texels[i * 4 + alphaLane] >= cutoff ? 1 : 0;
+  return texelCount ? (float)covered / texelCount : 0.0f;
+}
+
+float FindCoverageScale(const FloatImage& image, int alphaLane, float cutoff,
+  float coverage, std::vector<float>& alphas) {
+  size_t texelCount = (size_t)image.width * image.height;
+  size_t targetCount = (size_t)std::lround(coverage * texelCount);
+  if (targetCount == 0)
+    return 1.0f;
+  alphas.resize(texelCount);
+  for (size_t i = 0; i < texelCount; i++)
+    alphas[i] = image.texels[i * 4 + alphaLane];
+  // 큰 값부터 정렬했을 때 targetCount번째 값
+  auto nth = alphas.begin() + (targetCount - 1);
+  std::nth_element(alphas.begin(), nth, alphas.end(), std::greater<float>());
+  float value = *nth;
+  if (value <= 0.0f)
+    return 1.0f;
+
+  // value를 통과시키면 value 이상이 모두, 떨어뜨리면 value보다 큰 것만 통과
+  size_t aboveCount = 0;
+  size_t equalCount = 0;
+  float nextValue = 0.0f;
+  for (auto alpha : alphas) {
+    if (alpha > value) {
+      nextValue = aboveCount == 0 ? alpha : std::min(nextValue, alpha);
+      aboveCount++;
+    }
+    else if (alpha == value) {
+      equalCount++;
+    }
+  }
+  size_t includeCount = aboveCount + equalCount;
+  if (includeCount - targetCount <= targetCount - aboveCount)
+    return cutoff / value;
+  // value 바로 위의 값이 cutoff가 되도록 (없으면 모두 cutoff 아래로)
+  return aboveCount > 0 ? cutoff / nextValue : cutoff / value * 0.99f;
+}
+
+} // namespace
+
+std::vector<ImageUPtr> MipmapGenerator::Generate(const Image* image,
+  const MipmapOptions& options) {
+  std::vector<ImageUPtr> levels;
+  int channelCount = image->GetChannelCount();
+  if (channelCount < 1 || channelCount > 4 || !image->GetData()) {
+    SPDLOG_ERROR("unsupported image for mipmap: {} channels", channelCount);
+    return levels;
+  }
+  ChannelLayout layout(channelCount, options.srgb);
+  bool keepCoverage = layout.alphaLane >= 0 && options.alphaCutoff > 0.0f;
+
+  FloatImage current;
+  FloatImage next;
+  FloatImage temp;
+  std::vector<float> alphas;
+  Decode(image, layout, current);
+  float coverage = keepCoverage ?
+    ComputeCoverage(current, layout.alphaLane, options.alphaCutoff) : 0.0f;
+
+  while (current.width > 1 || current.height > 1) {
+    next.Resize(std::max(1, current.width / 2), std::max(1, current.height / 2));
+    if (options.filter == MipmapOptions::Filter::Kaiser)
+      DownsampleKaiser(current, next, temp);
+    else
+      DownsampleBox(current, next);
+
+    // scale은 출력에만 적용 (다음 level은 scale 전 값에서 계산)
+    float alphaScale = keepCoverage ?
+      FindCoverageScale(next, layout.alphaLane, options.alphaCutoff, coverage, alphas) : 1.0f;
+    auto level = Image::Create(next.width, next.height, channelCount);
+    if (!level) {
+      SPDLOG_ERROR("failed to allocate mipmap level {}x{}", next.width, next.height);
+      return std::vector<ImageUPtr>();
+    }
+    Encode(next, layout, alphaScale, level.get());
+    levels.push_back(std::move(level));
+    std::swap(current, next);
+  }
+  return levels;
+}
+
+const char* GetMipmapImplementation() {
+#if defined(MIPMAP_AVX2)
+  return "avx2";
+#elif defined(MIPMAP_SSE)
+  return "sse";
+#elif defined(MIPMAP_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
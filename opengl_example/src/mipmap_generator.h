@@ -0,0 +1,39 @@
+#ifndef __MIPMAP_GENERATOR_H__
+#define __MIPMAP_GENERATOR_H__
+
+#include "image.h"
+#include <vector>
+
+struct MipmapOptions {
+  enum class Filter {
+    // 2x2 평균 (가장 빠름)
+    Box,
+    // Kaiser window를 씌운 sinc (6 tap): 더 선명하고 aliasing이 적음
+    Kaiser,
+  };
+  Filter filter { Filter::Box };
+  // color channel이 sRGB로 저장된 색인지 (specular, normal map 같은 데이터 texture는 false)
+  bool srgb { true };
+  // 0보다 크면 alpha test 기준값: level마다 alpha >= alphaCutoff인 texel 비율을
+  // level 0과 같게 맞춰서 멀어질수록 잎사귀 등이 얇아지다 사라지는 것을 막음
+  float alphaCutoff { 0.0f };
+};
+
+/*
+** CPU mipmap 생성 (glGenerateMipmap 대신, worker thread에서 실행)
+  - level 0을 float linear 값으로 바꾼 뒤(sRGB면 sRGB -> linear) level마다 이전 level에서 축소
+    -> 8bit로 다시 양자화한 값을 쌓아 가지 않고, 밝기 평균이 gamma 때문에 어두워지지 않음
+  - texel 하나를 float 4개로 두고 SSE2 / AVX2 / NEON으로 4 (AVX2는 8) lane씩 계산
+  - 출력 level은 원본과 같은 channel 수의 8bit (sRGB면 다시 sRGB로 인코딩)
+  - 홀수 크기는 마지막 줄 / 열을 버리는 2x 축소 (1x1 level까지 생성)
+*/
+class MipmapGenerator {
+public:
+  // image의 level 1부터 1x1까지 (image가 1x1이면 빈 목록)
+  static std::vector<ImageUPtr> Generate(const Image* image,
+    const MipmapOptions& options = MipmapOptions());
+};
+
+const char* GetMipmapImplementation();
+
+#endif // __MIPMAP_GENERATOR_H__
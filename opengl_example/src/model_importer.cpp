@@ -0,0 +1,779 @@
+#include "model_importer.h"
+#include "mapped_file.h"
+#include "json.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+int ModelImporter::GetDefaultThreadCount() {
+  return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+// 작업 count개를 threadCount개의 thread가 나눠서 실행 (호출한 thread도 같이 일함)
+template <typename Func>
+static void ParallelFor(size_t count, int threadCount, const Func& func) {
+  size_t workerCount = std::min(count, (size_t)std::max(threadCount, 1));
+  if (workerCount <= 1) {
+    for (size_t i = 0; i < count; i++)
+      func(i);
+    return;
+  }
+  std::atomic<size_t> next { 0 };
+  auto worker = [&]() {
+    for (size_t i = next++; i < count; i = next++)
+      func(i);
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(workerCount - 1);
+  for (size_t i = 1; i < workerCount; i++)
+    threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads)
+    thread.join();
+}
+
+// normal이 없는 정점은 붙어 있는 삼각형 normal의 합(= 면적 가중 평균)으로 계산
+static void ComputeMissingNormals(std::vector<MeshVertex>& vertices,
+  const std::vector<uint32_t>& indices, const std::vector<uint8_t>& missing) {
+  for (size_t i = 0; i < vertices.size(); i++) {
+    if (missing[i])
+      vertices[i].normal = glm::vec3(0.0f);
+  }
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    uint32_t i0 = indices[i];
+    uint32_t i1 = indices[i + 1];
+    uint32_t i2 = indices[i + 2];
+    if (!missing[i0] && !missing[i1] && !missing[i2])
+      continue;
+    auto faceNormal = glm::cross(
+      vertices[i1].position - vertices[i0].position,
+      vertices[i2].position - vertices[i0].position);
+    for (auto index : { i0, i1, i2 }) {
+      if (missing[index])
+        vertices[index].normal += faceNormal;
+    }
+  }
+  for (size_t i = 0; i < vertices.size(); i++) {
+    if (!missing[i])
+      continue;
+    float length = glm::length(vertices[i].normal);
+    vertices[i].normal = length > 0.0f ? vertices[i].normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+  }
+}
+
+static bool EndsWith(const std::string& text, const char* suffix) {
+  size_t length = strlen(suffix);
+  if (text.size() < length)
+    return false;
+  for (size_t i = 0; i < length; i++) {
+    if (tolower((unsigned char)text[text.size() - length + i]) != suffix[i])
+      return false;
+  }
+  return true;
+}
+
+std::optional<MeshData> ModelImporter::Load(const std::string& filename, int threadCount) {
+  if (EndsWith(filename, ".obj"))
+    return LoadObj(filename, threadCount);
+  if (EndsWith(filename, ".gltf"))
+    return LoadGltf(filename, threadCount);
+  SPDLOG_ERROR("unsupported model format: {}", filename);
+  return {};
+}
+
+/*
+** Wavefront OBJ
+  v x y z / vt u v / vn x y z / f v/vt/vn ... 만 읽고 나머지 줄(o, g, s, usemtl 등)은 무시
+  - 음수 index는 그 줄 앞까지 나온 개수 기준 상대 위치
+    -> chunk를 따로 읽으면 앞 chunk의 개수를 모르므로 chunk 기준으로 기록했다가 나중에 더함
+  - 다각형은 첫 정점 기준 fan으로 삼각형 분할
+*/
+static constexpr int32_t OBJ_MISSING = INT32_MIN;
+
+struct ObjCorner {
+  // position, texCoord, normal (없으면 OBJ_MISSING)
+  int32_t index[3];
+  // bit k: index[k]가 chunk 기준 0부터 시작하는 상대 위치
+  uint8_t relative;
+};
+
+struct ObjVertexKey {
+  uint32_t index[3];
+  bool operator==(const ObjVertexKey& other) const {
+    return index[0] == other.index[0] && index[1] == other.index[1] &&
+      index[2] == other.index[2];
+  }
+};
+
+struct ObjVertexKeyHash {
+  size_t operator()(const ObjVertexKey& key) const {
+    uint64_t hash = key.index[0] * 0x9E3779B97F4A7C15ull;
+    hash ^= (key.index[1] + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+    hash ^= (key.index[2] + 0x85EBCA77C2B2AE63ull) * 0x165667B19E3779F9ull;
+    return (size_t)(hash ^ (hash >> 29));
+  }
+};
+
+// 선형 탐사(open addressing) hash table
+// std::unordered_map과 달리 원소마다 node를 할당하지 않고 slot 배열 하나에 key와 값을 같이 저장
+class ObjVertexMap {
+public:
+  void Reserve(size_t count) {
+    size_t capacity = 16;
+    while (capacity < count * 2)
+      capacity *= 2;
+    if (capacity > m_slots.size())
+      Rehash(capacity);
+  }
+
+  // key가 없으면 value로 추가, 있으면 기존 값을 돌려줌 (second: 새로 추가했는지)
+  std::pair<uint32_t, bool> Insert(const ObjVertexKey& key, uint32_t value) {
+    if ((m_count + 1) * 2 > m_slots.size())
+      Rehash(std::max((size_t)16, m_slots.size() * 2));
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = ObjVertexKeyHash()(key) & mask; ; i = (i + 1) & mask) {
+      auto& slot = m_slots[i];
+      if (slot.value == INVALID_INDEX) {
+        slot.key = key;
+        slot.value = value;
+        m_count++;
+        return { value, true };
+      }
+      if (slot.key == key)
+        return { slot.value, false };
+    }
+  }
+
+private:
+  struct Slot {
+    ObjVertexKey key;
+    uint32_t value { INVALID_INDEX };
+  };
+
+  void Rehash(size_t capacity) {
+    std::vector<Slot> slots(capacity);
+    size_t mask = capacity - 1;
+    for (const auto& slot : m_slots) {
+      if (slot.value == INVALID_INDEX)
+        continue;
+      size_t i = ObjVertexKeyHash()(slot.key) & mask;
+      while (slots[i].value != INVALID_INDEX)
+        i = (i + 1) & mask;
+      slots[i] = slot;
+    }
+    m_slots = std::move(slots);
+  }
+
+  std::vector<Slot> m_slots;
+  size_t m_count { 0 };
+};
+
+struct ObjChunk {
+  const char* begin { nullptr };
+  const char* end { nullptr };
+  // 1단계: parsing 결과
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> texCoords;
+  std::vector<glm::vec3> normals;
+  std::vector<ObjCorner> corners;
+  std::vector<ObjCorner> faceScratch;
+  size_t invalidLineCount { 0 };
+  // 2단계: chunk 안에서 중복 제거
+  std::vector<uint32_t> localIndices;
+  std::vector<ObjVertexKey> uniqueKeys;
+  size_t invalidIndexCount { 0 };
+  // 3단계: chunk 고유 정점 번호 -> 전체 정점 번호
+  std::vector<uint32_t> remap;
+  size_t indexOffset { 0 };
+};
+
+static const char* SkipSpaces(const char* p, const char* end) {
+  while (p < end && (*p == ' ' || *p == '\t'))
+    p++;
+  return p;
+}
+
+static bool ParseFloats(const char*& p, const char* end, float* values, int count) {
+  for (int i = 0; i < count; i++) {
+    p = SkipSpaces(p, end);
+    if (p < end && *p == '+')
+      p++;
+    auto result = std::from_chars(p, end, values[i]);
+    if (result.ec != std::errc())
+      return false;
+    p = result.ptr;
+  }
+  return true;
+}
+
+static bool ParseObjIndex(const char*& p, const char* end, const size_t* localCounts,
+  int component, ObjCorner& corner) {
+  int32_t value = 0;
+  auto result = std::from_chars(p, end, value);
+  if (result.ec != std::errc() || value == 0)
+    return false;
+  p = result.ptr;
+  if (value > 0) {
+    corner.index[component] = value;
+  }
+  else {
+    corner.index[component] = (int32_t)localCounts[component] + value;
+    corner.relative |= (uint8_t)(1 << component);
+  }
+  return true;
+}
+
+static bool ParseObjFace(const char* p, const char* end, ObjChunk& chunk) {
+  const size_t localCounts[3] = {
+    chunk.positions.size(), chunk.texCoords.size(), chunk.normals.size() };
+  chunk.faceScratch.clear();
+  while (true) {
+    p = SkipSpaces(p, end);
+    if (p == end || *p == '\r' || *p == '#')
+      break;
+    ObjCorner corner = { { OBJ_MISSING, OBJ_MISSING, OBJ_MISSING }, 0 };
+    if (!ParseObjIndex(p, end, localCounts, 0, corner))
+      return false;
+    if (p < end && *p == '/') {
+      p++;
+      if (p < end && *p != '/' && !ParseObjIndex(p, end, localCounts, 1, corner))
+        return false;
+      if (p < end && *p == '/') {
+        p++;
+        if (!ParseObjIndex(p, end, localCounts, 2, corner))
+          return false;
+      }
+    }
+    chunk.faceScratch.push_back(corner);
+  }
+  if (chunk.faceScratch.size() < 3)
+    return false;
+  for (size_t i = 1; i + 1 < chunk.faceScratch.size(); i++) {
+    chunk.corners.push_back(chunk.faceScratch[0]);
+    chunk.corners.push_back(chunk.faceScratch[i]);
+    chunk.corners.push_back(chunk.faceScratch[i + 1]);
+  }
+  return true;
+}
+
+static void ParseObjChunk(ObjChunk& chunk) {
+  const char* p = chunk.begin;
+  while (p < chunk.end) {
+    auto lineEnd = (const char*)memchr(p, '\n', chunk.end - p);
+    if (!lineEnd)
+      lineEnd = chunk.end;
+    const char* line = SkipSpaces(p, lineEnd);
+    p = lineEnd + 1;
+    if (lineEnd - line < 2)
+      continue;
+
+    bool valid = true;
+    if (line[0] == 'v' && (line[1] == ' ' || line[1] == '\t')) {
+      glm::vec3 position(0.0f);
+      line += 1;
+      valid = ParseFloats(line, lineEnd, &position.x, 3);
+      chunk.positions.push_back(position);
+    }
+    else if (line[0] == 'v' && line[1] == 't') {
+      glm::vec2 texCoord(0.0f);
+      line += 2;
+      valid = ParseFloats(line, lineEnd, &texCoord.x, 2);
+      chunk.texCoords.push_back(texCoord);
+    }
+    else if (line[0] == 'v' && line[1] == 'n') {
+      glm::vec3 normal(0.0f);
+      line += 2;
+      valid = ParseFloats(line, lineEnd, &normal.x, 3);
+      chunk.normals.push_back(normal);
+    }
+    else if (line[0] == 'f' && (line[1] == ' ' || line[1] == '\t')) {
+      valid = ParseObjFace(line + 1, lineEnd, chunk);
+    }
+    // 잘못된 v / vt / vn 줄도 번호는 차지하므로 0으로 채운 값을 넣어둠
+    if (!valid)
+      chunk.invalidLineCount++;
+  }
+}
+
+// chunk 기준 index를 전체 기준 0부터 시작하는 index로 (범위 밖이면 INVALID_INDEX)
+static uint32_t ResolveObjIndex(const ObjCorner& corner, int component,
+  const size_t* bases, const size_t* totals) {
+  int64_t value = corner.index[component];
+  if (value == OBJ_MISSING)
+    return INVALID_INDEX;
+  int64_t index = (corner.relative & (1 << component)) ?
+    (int64_t)bases[component] + value : value - 1;
+  if (index < 0 || index >= (int64_t)totals[component])
+    return INVALID_INDEX;
+  return (uint32_t)index;
+}
+
+std::optional<MeshData> ModelImporter::LoadObj(const std::string& filename, int threadCount) {
+  auto file = MappedFile::Open(filename);
+  if (!file)
+    return {};
+  if (threadCount <= 0)
+    threadCount = GetDefaultThreadCount();
+
+  // 줄 중간에서 자르지 않도록 각 경계를 다음 줄의 시작으로 옮김
+  // 작은 파일은 thread를 만드는 비용이 더 크므로 chunk 하나에 최소 1MB
+  const char* data = (const char*)file->GetData();
+  size_t size = file->GetSize();
+  size_t chunkCount = std::clamp(size / (1 << 20), (size_t)1, (size_t)threadCount);
+  std::vector<ObjChunk> chunks(chunkCount);
+  const char* chunkBegin = data;
+  for (size_t i = 0; i < chunkCount; i++) {
+    const char* chunkEnd = data + size * (i + 1) / chunkCount;
+    if (i + 1 < chunkCount) {
+      auto newline = (const char*)memchr(chunkEnd, '\n', data + size - chunkEnd);
+      chunkEnd = newline ? newline + 1 : data + size;
+    }
+    chunks[i].begin = chunkBegin;
+    chunks[i].end = std::max(chunkBegin, chunkEnd);
+    chunkBegin = chunks[i].end;
+  }
+
+  // 1단계: chunk 별 parsing
+  ParallelFor(chunkCount, threadCount, [&](size_t i) {
+    ParseObjChunk(chunks[i]);
+  });
+
+  std::vector<size_t> bases(chunkCount * 3);
+  size_t totals[3] = {};
+  size_t invalidLineCount = 0;
+  for (size_t i = 0; i < chunkCount; i++) {
+    const auto& chunk = chunks[i];
+    bases[i * 3 + 0] = totals[0];
+    bases[i * 3 + 1] = totals[1];
+    bases[i * 3 + 2] = totals[2];
+    totals[0] += chunk.positions.size();
+    totals[1] += chunk.texCoords.size();
+    totals[2] += chunk.normals.size();
+    invalidLineCount += chunk.invalidLineCount;
+  }
+  if (invalidLineCount > 0)
+    SPDLOG_WARN("{}: skipped {} invalid lines", filename, invalidLineCount);
+
+  // 2단계: chunk 안에서 (position, texCoord, normal) 조합 중복 제거
+  ParallelFor(chunkCount, threadCount, [&](size_t i) {
+    auto& chunk = chunks[i];
+    // 보통 한 정점을 삼각형 여러 개가 공유하므로 고유 정점은 corner 수보다 훨씬 적다
+    ObjVertexMap vertexMap;
+    vertexMap.Reserve(chunk.corners.size() / 4);
+    chunk.localIndices.reserve(chunk.corners.size());
+    for (size_t c = 0; c + 2 < chunk.corners.size(); c += 3) {
+      ObjVertexKey keys[3];
+      bool valid = true;
+      for (int k = 0; k < 3; k++) {
+        for (int component = 0; component < 3; component++) {
+          keys[k].index[component] = ResolveObjIndex(chunk.corners[c + k], component,
+            &bases[i * 3], totals);
+        }
+        valid = valid && keys[k].index[0] != INVALID_INDEX;
+      }
+      // position이 없는 삼각형은 버림
+      if (!valid) {
+        chunk.invalidIndexCount++;
+        continue;
+      }
+      for (const auto& key : keys) {
+        auto result = vertexMap.Insert(key, (uint32_t)chunk.uniqueKeys.size());
+        if (result.second)
+          chunk.uniqueKeys.push_back(key);
+        chunk.localIndices.push_back(result.first);
+      }
+    }
+    std::vector<ObjCorner>().swap(chunk.corners);
+  });
+
+  // 3단계: chunk 경계에서 겹치는 조합을 합쳐 전체 정점 번호를 정함 (고유 조합만 보므로 빠름)
+  // chunk가 하나면 chunk 번호가 그대로 전체 번호
+  std::vector<ObjVertexKey> globalKeys;
+  size_t indexCount = 0;
+  size_t invalidFaceCount = 0;
+  if (chunkCount == 1) {
+    globalKeys = std::move(chunks[0].uniqueKeys);
+    indexCount = chunks[0].localIndices.size();
+    invalidFaceCount = chunks[0].invalidIndexCount;
+  }
+  else {
+    ObjVertexMap globalMap;
+    size_t uniqueCount = 0;
+    for (const auto& chunk : chunks)
+      uniqueCount += chunk.uniqueKeys.size();
+    globalMap.Reserve(uniqueCount);
+    for (auto& chunk : chunks) {
+      chunk.remap.resize(chunk.uniqueKeys.size());
+      for (size_t k = 0; k < chunk.uniqueKeys.size(); k++) {
+        auto result = globalMap.Insert(chunk.uniqueKeys[k], (uint32_t)globalKeys.size());
+        if (result.second)
+          globalKeys.push_back(chunk.uniqueKeys[k]);
+        chunk.remap[k] = result.first;
+      }
+      chunk.indexOffset = indexCount;
+      indexCount += chunk.localIndices.size();
+      invalidFaceCount += chunk.invalidIndexCount;
+    }
+  }
+  if (invalidFaceCount > 0)
+    SPDLOG_WARN("{}: skipped {} triangles with invalid indices", filename, invalidFaceCount);
+  if (globalKeys.empty() || indexCount == 0) {
+    SPDLOG_ERROR("no triangles in model: {}", filename);
+    return {};
+  }
+
+  // 4단계: index / 정점 데이터 작성
+  std::vector<uint32_t> indices;
+  if (chunkCount == 1) {
+    indices = std::move(chunks[0].localIndices);
+  }
+  else {
+    indices.resize(indexCount);
+    ParallelFor(chunkCount, threadCount, [&](size_t i) {
+      const auto& chunk = chunks[i];
+      auto out = indices.data() + chunk.indexOffset;
+      for (size_t k = 0; k < chunk.localIndices.size(); k++)
+        out[k] = chunk.remap[chunk.localIndices[k]];
+    });
+  }
+
+  // position 등은 chunk 별로 나뉘어 있으므로 전체 번호 -> (chunk, 위치)로 찾기 위해 이어붙임
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> texCoords;
+  std::vector<glm::vec3> normals;
+  positions.reserve(totals[0]);
+  texCoords.reserve(totals[1]);
+  normals.reserve(totals[2]);
+  for (auto& chunk : chunks) {
+    positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+    texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+    normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+  }
+
+  std::vector<MeshVertex> vertices(globalKeys.size());
+  std::vector<uint8_t> missingNormals(globalKeys.size(), 0);
+  std::atomic<bool> hasMissingNormal { false };
+  const size_t blockSize = 1 << 16;
+  ParallelFor((vertices.size() + blockSize - 1) / blockSize, threadCount, [&](size_t block) {
+    size_t end = std::min(vertices.size(), (block + 1) * blockSize);
+    for (size_t i = block * blockSize; i < end; i++) {
+      const auto& key = globalKeys[i];
+      auto& vertex = vertices[i];
+      vertex.position = positions[key.index[0]];
+      vertex.texCoord = key.index[1] != INVALID_INDEX ? texCoords[key.index[1]] : glm::vec2(0.0f);
+      if (key.index[2] != INVALID_INDEX) {
+        vertex.normal = normals[key.index[2]];
+      }
+      else {
+        missingNormals[i] = 1;
+        hasMissingNormal = true;
+      }
+    }
+  });
+  if (hasMissingNormal)
+    ComputeMissingNormals(vertices, indices, missingNormals);
+
+  MeshData mesh;
+  mesh.SetVertices(vertices.data(), vertices.size());
+  mesh.indices = std::move(indices);
+  return mesh;
+}
+
+/*
+** glTF 2.0
+  - accessor: bufferView 안에서 count개의 원소(SCALAR / VEC2 / VEC3 ...)를 읽는 방법
+  - bufferView: buffer(.bin) 안의 byte 범위와 원소 간격(byteStride)
+  - TEXCOORD_0의 원점은 왼쪽 위이므로 v를 뒤집음 (Image는 아래쪽부터 올라가도록 뒤집어 읽음)
+*/
+struct GltfAccessor {
+  const uint8_t* data { nullptr };
+  size_t count { 0 };
+  size_t stride { 0 };
+  uint32_t componentType { 0 };
+  int componentCount { 0 };
+  bool normalized { false };
+};
+
+static size_t GetComponentSize(uint32_t componentType) {
+  switch (componentType) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE: return 1;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT: return 2;
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT: return 4;
+    default: return 0;
+  }
+}
+
+static int GetComponentCount(const std::string& type) {
+  if (type == "SCALAR") return 1;
+  if (type == "VEC2") return 2;
+  if (type == "VEC3") return 3;
+  if (type == "VEC4") return 4;
+  return 0;
+}
+
+static bool GetGltfAccessor(const JsonValue& gltf, const std::vector<MappedFileUPtr>& buffers,
+  int64_t accessorIndex, GltfAccessor& accessor) {
+  const auto& json = gltf["accessors"][(size_t)accessorIndex];
+  const auto& view = gltf["bufferViews"][(size_t)json["bufferView"].GetInt(-1)];
+  int64_t bufferIndex = view["buffer"].GetInt(-1);
+  if (!json.IsObject() || !view.IsObject() ||
+    bufferIndex < 0 || bufferIndex >= (int64_t)buffers.size()) {
+    SPDLOG_ERROR("invalid gltf accessor: {}", accessorIndex);
+    return false;
+  }
+  accessor.componentType = (uint32_t)json["componentType"].GetInt();
+  accessor.componentCount = GetComponentCount(json["type"].GetString());
+  accessor.count = (size_t)json["count"].GetInt();
+  accessor.normalized = json["normalized"].GetBool();
+  size_t elementSize = GetComponentSize(accessor.componentType) * accessor.componentCount;
+  accessor.stride = (size_t)view["byteStride"].GetInt(0);
+  if (accessor.stride == 0)
+    accessor.stride = elementSize;
+
+  const auto& buffer = buffers[bufferIndex];
+  uint64_t viewOffset = (uint64_t)view["byteOffset"].GetInt(0);
+  uint64_t viewLength = (uint64_t)view["byteLength"].GetInt(0);
+  uint64_t offset = (uint64_t)json["byteOffset"].GetInt(0);
+  uint64_t needed = accessor.count > 0 ?
+    offset + accessor.stride * (accessor.count - 1) + elementSize : 0;
+  if (elementSize == 0 || viewOffset + viewLength > buffer->GetSize() || needed > viewLength) {
+    SPDLOG_ERROR("gltf accessor {} out of buffer range", accessorIndex);
+    return false;
+  }
+  accessor.data = buffer->GetData() + viewOffset + offset;
+  return true;
+}
+
+// 원소 하나의 component들을 float로 (정규화 정수는 [0, 1] 또는 [-1, 1]로)
+static void ReadGltfFloats(const GltfAccessor& accessor, size_t index, float* out, int count) {
+  const uint8_t* p = accessor.data + accessor.stride * index;
+  int n = std::min(count, accessor.componentCount);
+  for (int c = 0; c < n; c++) {
+    float value = 0.0f;
+    switch (accessor.componentType) {
+      case GL_FLOAT: memcpy(&value, p + c * 4, 4); break;
+      case GL_UNSIGNED_BYTE: {
+        value = (float)p[c];
+        if (accessor.normalized) value /= 255.0f;
+        break;
+      }
+      case GL_BYTE: {
+        value = (float)(int8_t)p[c];
+        if (accessor.normalized) value = std::max(value / 127.0f, -1.0f);
+        break;
+      }
+      case GL_UNSIGNED_SHORT: {
+        uint16_t v;
+        memcpy(&v, p + c * 2, 2);
+        value = (float)v;
+        if (accessor.normalized) value /= 65535.0f;
+        break;
+      }
+      case GL_SHORT: {
+        int16_t v;
+        memcpy(&v, p + c * 2, 2);
+        value = (float)v;
+        if (accessor.normalized) value = std::max(value / 32767.0f, -1.0f);
+        break;
+      }
+    }
+    out[c] = value;
+  }
+}
+
+static uint32_t ReadGltfIndex(const GltfAccessor& accessor, size_t index) {
+  const uint8_t* p = accessor.data + accessor.stride * index;
+  switch (accessor.componentType) {
+    case GL_UNSIGNED_BYTE: return p[0];
+    case GL_UNSIGNED_SHORT: {
+      uint16_t v;
+      memcpy(&v, p, 2);
+      return v;
+    }
+    case GL_UNSIGNED_INT: {
+      uint32_t v;
+      memcpy(&v, p, 4);
+      return v;
+    }
+    default: return INVALID_INDEX;
+  }
+}
+
+struct GltfPrimitive {
+  GltfAccessor position;
+  GltfAccessor normal;
+  GltfAccessor texCoord;
+  GltfAccessor indices;
+  size_t vertexOffset { 0 };
+  size_t indexOffset { 0 };
+  size_t indexCount { 0 };
+};
+
+// 병렬 변환 단위: primitive 하나의 [begin, end) 정점 또는 index 구간
+struct GltfBlock {
+  size_t primitive;
+  bool indices;
+  size_t begin;
+  size_t end;
+};
+
+std::optional<MeshData> ModelImporter::LoadGltf(const std::string& filename, int threadCount) {
+  auto text = LoadTextFile(filename);
+  if (!text)
+    return {};
+  auto json = JsonValue::Parse(text->data(), text->size());
+  if (!json)
+    return {};
+  const auto& gltf = *json;
+  if (threadCount <= 0)
+    threadCount = GetDefaultThreadCount();
+
+  // .bin은 .gltf와 같은 폴더 기준 상대 경로
+  auto slash = filename.find_last_of("/\\");
+  std::string directory = slash == std::string::npos ? "" : filename.substr(0, slash + 1);
+  std::vector<MappedFileUPtr> buffers;
+  for (size_t i = 0; i < gltf["buffers"].GetSize(); i++) {
+    const auto& uri = gltf["buffers"][i]["uri"].GetString();
+    if (uri.empty() || uri.compare(0, 5, "data:") == 0) {
+      SPDLOG_ERROR("unsupported gltf buffer (embedded or glb): {}", filename);
+      return {};
+    }
+    auto buffer = MappedFile::Open(directory + uri);
+    if (!buffer)
+      return {};
+    buffers.push_back(std::move(buffer));
+  }
+
+  std::vector<GltfPrimitive> primitives;
+  size_t vertexCount = 0;
+  size_t indexCount = 0;
+  const auto& meshes = gltf["meshes"];
+  for (size_t m = 0; m < meshes.GetSize(); m++) {
+    const auto& meshPrimitives = meshes[m]["primitives"];
+    for (size_t p = 0; p < meshPrimitives.GetSize(); p++) {
+      const auto& json = meshPrimitives[p];
+      const auto& attributes = json["attributes"];
+      // mode 4 = TRIANGLES (기본값)
+      if (json["mode"].GetInt(4) != 4 || !attributes.Has("POSITION")) {
+        SPDLOG_WARN("{}: skipped non-triangle primitive {} of mesh {}", filename, p, m);
+        continue;
+      }
+      GltfPrimitive primitive;
+      if (!GetGltfAccessor(gltf, buffers, attributes["POSITION"].GetInt(), primitive.position))
+        return {};
+      if (attributes.Has("NORMAL") &&
+        !GetGltfAccessor(gltf, buffers, attributes["NORMAL"].GetInt(), primitive.normal))
+        return {};
+      if (attributes.Has("TEXCOORD_0") &&
+        !GetGltfAccessor(gltf, buffers, attributes["TEXCOORD_0"].GetInt(), primitive.texCoord))
+        return {};
+      if (json.Has("indices") &&
+        !GetGltfAccessor(gltf, buffers, json["indices"].GetInt(), primitive.indices))
+        return {};
+      primitive.indexCount = primitive.indices.data ?
+        primitive.indices.count : primitive.position.count;
+      // 삼각형 목록이 아니면 index를 3개씩 묶을 수 없음
+      if (primitive.indexCount % 3 != 0) {
+        SPDLOG_WARN("{}: skipped primitive {} of mesh {} with {} indices (not a multiple of 3)",
+          filename, p, m, primitive.indexCount);
+        continue;
+      }
+      primitive.vertexOffset = vertexCount;
+      primitive.indexOffset = indexCount;
+      vertexCount += primitive.position.count;
+      indexCount += primitive.indexCount;
+      primitives.push_back(primitive);
+    }
+  }
+  if (vertexCount == 0 || indexCount == 0 || vertexCount >= INVALID_INDEX) {
+    SPDLOG_ERROR("no triangles in model: {}", filename);
+    return {};
+  }
+
+  const size_t blockSize = 1 << 16;
+  std::vector<GltfBlock> blocks;
+  for (size_t p = 0; p < primitives.size(); p++) {
+    for (size_t begin = 0; begin < primitives[p].position.count; begin += blockSize)
+      blocks.push_back({ p, false, begin, std::min(primitives[p].position.count, begin + blockSize) });
+    for (size_t begin = 0; begin < primitives[p].indexCount; begin += blockSize)
+      blocks.push_back({ p, true, begin, std::min(primitives[p].indexCount, begin + blockSize) });
+  }
+
+  std::vector<MeshVertex> vertices(vertexCount);
+  std::vector<uint32_t> indices(indexCount);
+  std::vector<uint8_t> missingNormals(vertexCount, 0);
+  std::atomic<bool> hasMissingNormal { false };
+  std::atomic<size_t> invalidIndexCount { 0 };
+  ParallelFor(blocks.size(), threadCount, [&](size_t b) {
+    const auto& block = blocks[b];
+    const auto& primitive = primitives[block.primitive];
+    if (block.indices) {
+      auto out = indices.data() + primitive.indexOffset;
+      size_t invalid = 0;
+      for (size_t i = block.begin; i < block.end; i++) {
+        uint32_t index = primitive.indices.data ? ReadGltfIndex(primitive.indices, i) : (uint32_t)i;
+        // 범위 밖 index는 표시만 해두고 아래에서 그 삼각형을 통째로 버림
+        if (index >= primitive.position.count) {
+          out[i] = INVALID_INDEX;
+          invalid++;
+          continue;
+        }
+        out[i] = (uint32_t)primitive.vertexOffset + index;
+      }
+      if (invalid > 0)
+        invalidIndexCount += invalid;
+      return;
+    }
+    auto out = vertices.data() + primitive.vertexOffset;
+    for (size_t i = block.begin; i < block.end; i++) {
+      auto& vertex = out[i];
+      ReadGltfFloats(primitive.position, i, &vertex.position.x, 3);
+      vertex.texCoord = glm::vec2(0.0f);
+      if (primitive.texCoord.data) {
+        ReadGltfFloats(primitive.texCoord, i, &vertex.texCoord.x, 2);
+        vertex.texCoord.y = 1.0f - vertex.texCoord.y;
+      }
+      if (primitive.normal.data) {
+        ReadGltfFloats(primitive.normal, i, &vertex.normal.x, 3);
+      }
+      else {
+        missingNormals[primitive.vertexOffset + i] = 1;
+        hasMissingNormal = true;
+      }
+    }
+  });
+  // OBJ와 같이 잘못된 index가 있는 삼각형은 버림 (block 경계가 삼각형 단위가 아니므로 따로 모음)
+  if (invalidIndexCount > 0) {
+    size_t count = 0;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+      if (indices[i] == INVALID_INDEX || indices[i + 1] == INVALID_INDEX ||
+        indices[i + 2] == INVALID_INDEX)
+        continue;
+      indices[count++] = indices[i];
+      indices[count++] = indices[i + 1];
+      indices[count++] = indices[i + 2];
+    }
+    SPDLOG_WARN("{}: skipped {} triangles with invalid indices", filename,
+      (indices.size() - count) / 3);
+    indices.resize(count);
+    if (indices.empty()) {
+      SPDLOG_ERROR("no triangles in model: {}", filename);
+      return {};
+    }
+  }
+  if (hasMissingNormal)
+    ComputeMissingNormals(vertices, indices, missingNormals);
+
+  MeshData mesh;
+  mesh.SetVertices(vertices.data(), vertices.size());
+  mesh.indices = std::move(indices);
+  return mesh;
+}
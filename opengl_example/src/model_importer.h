@@ -0,0 +1,28 @@
+#ifndef __MODEL_IMPORTER_H__
+#define __MODEL_IMPORTER_H__
+
+#include "common.h"
+#include "mesh_data.h"
+
+/*
+** Model importer (Wavefront OBJ, glTF 2.0 .gltf + .bin)
+  결과는 MeshVertex 형식의 MeshData 하나 (여러 mesh / primitive는 하나로 합침)
+  - OBJ: 파일을 mmap 한 뒤 줄 경계에 맞춰 threadCount개의 chunk로 나누고
+    worker thread마다 std::from_chars로 숫자를 읽음
+    -> chunk마다 (position, texCoord, normal) 조합을 hash map으로 중복 제거한 뒤
+       chunk 사이에 겹치는 조합만 한 번 더 합쳐서 index buffer를 만듦
+  - glTF: JSON을 읽고 .bin을 mmap, accessor 데이터를 정점 구간별로 나눠 병렬 변환
+    (이미 index가 있는 형식이므로 중복 제거는 하지 않음, node transform은 적용하지 않음)
+  - normal이 없으면 삼각형 면적 가중 평균으로 계산
+*/
+class ModelImporter {
+public:
+  // threadCount가 0이면 std::thread::hardware_concurrency() 사용
+  static std::optional<MeshData> Load(const std::string& filename, int threadCount = 0);
+  static std::optional<MeshData> LoadObj(const std::string& filename, int threadCount = 0);
+  static std::optional<MeshData> LoadGltf(const std::string& filename, int threadCount = 0);
+
+  static int GetDefaultThreadCount();
+};
+
+#endif // __MODEL_IMPORTER_H__
@@ -0,0 +1,256 @@
+#include "offset_allocator.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// mask에서 가장 낮은 / 높은 1 bit의 위치 (mask는 0이 아니어야 함)
+static uint32_t FindLowestBit(uint32_t mask) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (uint32_t)index;
+#else
+  return (uint32_t)__builtin_ctz(mask);
+#endif
+}
+
+static uint32_t FindHighestBit(uint32_t mask) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanReverse(&index, mask);
+  return (uint32_t)index;
+#else
+  return 31 - (uint32_t)__builtin_clz(mask);
+#endif
+}
+
+/*
+크기 -> bin 번호: 지수 5bit + 가수 3bit의 작은 float로 변환
+  - 8 미만은 그대로 (denormal), 그 이상은 최상위 bit 다음 3bit를 가수로 사용
+  - 할당할 때는 올림: 그 bin의 어떤 블록을 꺼내도 요청 크기 이상임이 보장됨
+  - 빈 블록을 넣을 때는 내림: 블록 크기가 bin의 최소 크기 이상
+*/
+static constexpr uint32_t MANTISSA_BITS = 3;
+static constexpr uint32_t MANTISSA_VALUE = 1 << MANTISSA_BITS;
+static constexpr uint32_t MANTISSA_MASK = MANTISSA_VALUE - 1;
+
+static uint32_t SizeToBinRoundUp(uint32_t size) {
+  if (size < MANTISSA_VALUE)
+    return size;
+  uint32_t mantissaStartBit = FindHighestBit(size) - MANTISSA_BITS;
+  uint32_t exponent = mantissaStartBit + 1;
+  uint32_t mantissa = (size >> mantissaStartBit) & MANTISSA_MASK;
+  if (size & ((1u << mantissaStartBit) - 1))
+    mantissa++;
+  // 가수가 넘치면 자연스럽게 지수로 올라감
+  return (exponent << MANTISSA_BITS) + mantissa;
+}
+
+static uint32_t SizeToBinRoundDown(uint32_t size) {
+  if (size < MANTISSA_VALUE)
+    return size;
+  uint32_t mantissaStartBit = FindHighestBit(size) - MANTISSA_BITS;
+  uint32_t exponent = mantissaStartBit + 1;
+  uint32_t mantissa = (size >> mantissaStartBit) & MANTISSA_MASK;
+  return (exponent << MANTISSA_BITS) | mantissa;
+}
+
+OffsetAllocator::OffsetAllocator(uint32_t size, uint32_t maxAllocationCount)
+  : m_size(size) {
+  m_nodes.reserve(maxAllocationCount);
+  m_unusedNodes.reserve(maxAllocationCount);
+  Reset();
+}
+
+void OffsetAllocator::Reset() {
+  m_freeSize = 0;
+  m_freeBlockCount = 0;
+  m_allocationCount = 0;
+  m_topBinMask = 0;
+  std::fill(std::begin(m_binMasks), std::end(m_binMasks), 0);
+  std::fill(std::begin(m_binHeads), std::end(m_binHeads), INVALID);
+  m_nodes.clear();
+  m_unusedNodes.clear();
+  if (m_size > 0)
+    InsertFreeNode(0, m_size);
+}
+
+uint32_t OffsetAllocator::InsertFreeNode(uint32_t offset, uint32_t size) {
+  uint32_t bin = SizeToBinRoundDown(size);
+  uint32_t topIndex = bin / BINS_PER_TOP;
+  uint32_t leafIndex = bin % BINS_PER_TOP;
+
+  uint32_t nodeIndex;
+  if (!m_unusedNodes.empty()) {
+    nodeIndex = m_unusedNodes.back();
+    m_unusedNodes.pop_back();
+  }
+  else {
+    nodeIndex = (uint32_t)m_nodes.size();
+    m_nodes.emplace_back();
+  }
+
+  auto& node = m_nodes[nodeIndex];
+  node = Node();
+  node.offset = offset;
+  node.size = size;
+  node.binNext = m_binHeads[bin];
+  if (node.binNext != INVALID)
+    m_nodes[node.binNext].binPrev = nodeIndex;
+  m_binHeads[bin] = nodeIndex;
+
+  m_binMasks[topIndex] |= (uint8_t)(1u << leafIndex);
+  m_topBinMask |= 1u << topIndex;
+  m_freeSize += size;
+  m_freeBlockCount++;
+  return nodeIndex;
+}
+
+// unused 목록의 node는 항상 used == false (같은 Allocation을 두 번 Free()해도 무시되도록)
+// 재사용되어 다시 할당된 node는 generation이 달라 이전 Allocation의 Free()가 걸러짐
+void OffsetAllocator::ReleaseNode(uint32_t nodeIndex) {
+  m_nodes[nodeIndex].used = false;
+  m_unusedNodes.push_back(nodeIndex);
+}
+
+void OffsetAllocator::RemoveFreeNode(uint32_t nodeIndex) {
+  auto& node = m_nodes[nodeIndex];
+  if (node.binPrev != INVALID) {
+    m_nodes[node.binPrev].binNext = node.binNext;
+  }
+  else {
+    // bin의 첫 node였으면 head를 옮기고, bin이 비면 bit를 끔
+    uint32_t bin = SizeToBinRoundDown(node.size);
+    uint32_t topIndex = bin / BINS_PER_TOP;
+    uint32_t leafIndex = bin % BINS_PER_TOP;
+    m_binHeads[bin] = node.binNext;
+    if (node.binNext == INVALID) {
+      m_binMasks[topIndex] &= (uint8_t)~(1u << leafIndex);
+      if (m_binMasks[topIndex] == 0)
+        m_topBinMask &= ~(1u << topIndex);
+    }
+  }
+  if (node.binNext != INVALID)
+    m_nodes[node.binNext].binPrev = node.binPrev;
+  node.binPrev = INVALID;
+  node.binNext = INVALID;
+  m_freeSize -= node.size;
+  m_freeBlockCount--;
+}
+
+OffsetAllocator::Allocation OffsetAllocator::Allocate(uint32_t size) {
+  Allocation allocation;
+  if (size == 0 || size > m_freeSize)
+    return allocation;
+
+  // 요청 크기 이상을 보장하는 bin부터, 비어 있지 않은 가장 작은 bin을 bit mask로 찾음
+  uint32_t minBin = SizeToBinRoundUp(size);
+  uint32_t topIndex = minBin / BINS_PER_TOP;
+  uint32_t leafIndex = minBin % BINS_PER_TOP;
+  if (topIndex >= TOP_BIN_COUNT)
+    return allocation;
+
+  uint32_t bin = INVALID;
+  uint32_t leafMask = m_binMasks[topIndex] & (0xFFu << leafIndex) & 0xFFu;
+  if (leafMask) {
+    bin = topIndex * BINS_PER_TOP + FindLowestBit(leafMask);
+  }
+  else if (topIndex + 1 < TOP_BIN_COUNT) {
+    uint32_t topMask = m_topBinMask & (0xFFFFFFFFu << (topIndex + 1));
+    if (topMask) {
+      uint32_t top = FindLowestBit(topMask);
+      bin = top * BINS_PER_TOP + FindLowestBit(m_binMasks[top]);
+    }
+  }
+  if (bin == INVALID)
+    return allocation;
+
+  uint32_t nodeIndex = m_binHeads[bin];
+  RemoveFreeNode(nodeIndex);
+  m_nodes[nodeIndex].used = true;
+  m_nodes[nodeIndex].generation = ++m_generation;
+
+  // 남는 부분은 새 빈 블록으로 만들어 바로 뒤에 연결
+  uint32_t remainder = m_nodes[nodeIndex].size - size;
+  if (remainder > 0) {
+    m_nodes[nodeIndex].size = size;
+    uint32_t newIndex = InsertFreeNode(m_nodes[nodeIndex].offset + size, remainder);
+    auto& node = m_nodes[nodeIndex];
+    auto& newNode = m_nodes[newIndex];
+    newNode.neighborPrev = nodeIndex;
+    newNode.neighborNext = node.neighborNext;
+    if (node.neighborNext != INVALID)
+      m_nodes[node.neighborNext].neighborPrev = newIndex;
+    node.neighborNext = newIndex;
+  }
+
+  m_allocationCount++;
+  allocation.offset = m_nodes[nodeIndex].offset;
+  allocation.node = nodeIndex;
+  allocation.generation = m_nodes[nodeIndex].generation;
+  return allocation;
+}
+
+void OffsetAllocator::Free(const Allocation& allocation) {
+  if (!allocation.IsValid() || allocation.node >= m_nodes.size() ||
+    !m_nodes[allocation.node].used ||
+    m_nodes[allocation.node].generation != allocation.generation)
+    return;
+
+  // 먼저 used를 내려야 합쳐져서 unused 목록으로 간 node를 다시 Free()해도 위에서 걸러짐
+  m_nodes[allocation.node].used = false;
+  auto node = m_nodes[allocation.node];
+  uint32_t offset = node.offset;
+  uint32_t size = node.size;
+  uint32_t neighborPrev = node.neighborPrev;
+  uint32_t neighborNext = node.neighborNext;
+  ReleaseNode(allocation.node);
+
+  // 앞 / 뒤 블록이 비어 있으면 하나로 합침
+  if (neighborPrev != INVALID && !m_nodes[neighborPrev].used) {
+    const auto& prev = m_nodes[neighborPrev];
+    offset = prev.offset;
+    size += prev.size;
+    RemoveFreeNode(neighborPrev);
+    ReleaseNode(neighborPrev);
+    neighborPrev = prev.neighborPrev;
+  }
+  if (neighborNext != INVALID && !m_nodes[neighborNext].used) {
+    const auto& next = m_nodes[neighborNext];
+    size += next.size;
+    RemoveFreeNode(neighborNext);
+    ReleaseNode(neighborNext);
+    neighborNext = next.neighborNext;
+  }
+
+  uint32_t newIndex = InsertFreeNode(offset, size);
+  auto& newNode = m_nodes[newIndex];
+  newNode.neighborPrev = neighborPrev;
+  newNode.neighborNext = neighborNext;
+  if (neighborPrev != INVALID)
+    m_nodes[neighborPrev].neighborNext = newIndex;
+  if (neighborNext != INVALID)
+    m_nodes[neighborNext].neighborPrev = newIndex;
+  m_allocationCount--;
+}
+
+OffsetAllocator::Stats OffsetAllocator::GetStats() const {
+  Stats stats;
+  stats.size = m_size;
+  stats.freeSize = m_freeSize;
+  stats.usedSize = m_size - m_freeSize;
+  stats.freeBlockCount = m_freeBlockCount;
+  stats.allocationCount = m_allocationCount;
+  // 가장 큰 빈 블록은 비어 있지 않은 가장 높은 bin 안에 있다
+  if (m_topBinMask) {
+    uint32_t top = FindHighestBit(m_topBinMask);
+    uint32_t bin = top * BINS_PER_TOP + FindHighestBit(m_binMasks[top]);
+    for (uint32_t i = m_binHeads[bin]; i != INVALID; i = m_nodes[i].binNext)
+      stats.largestFreeBlock = std::max(stats.largestFreeBlock, m_nodes[i].size);
+  }
+  if (m_freeSize > 0)
+    stats.fragmentation = 1.0f - (float)stats.largestFreeBlock / (float)m_freeSize;
+  return stats;
+}
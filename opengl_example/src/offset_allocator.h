@@ -0,0 +1,88 @@
+#ifndef __OFFSET_ALLOCATOR_H__
+#define __OFFSET_ALLOCATOR_H__
+
+#include <cstdint>
+#include <vector>
+
+/*
+** TLSF(Two-Level Segregated Fit) offset allocator
+  실제 메모리가 아닌 [0, size) 범위의 offset만 관리 (GPU buffer 안의 영역 할당용)
+  - 빈 블록을 크기별 bin(지수 5bit + 가수 3bit = 256개)에 나눠 담고
+    bin마다 bit 하나로 비어 있는지 표시 -> 할당 / 해제 모두 O(1)
+  - 해제할 때 주소상 이웃한 빈 블록과 합쳐서(coalescing) 단편화를 줄임
+*/
+class OffsetAllocator {
+public:
+  static constexpr uint32_t INVALID = 0xFFFFFFFF;
+
+  struct Allocation {
+    uint32_t offset { INVALID };
+    // 해제할 때 넘겨줄 내부 node 번호
+    uint32_t node { INVALID };
+    // node는 재사용되므로 할당마다 다른 번호로 해제 대상이 맞는지 확인
+    uint32_t generation { 0 };
+    bool IsValid() const { return offset != INVALID; }
+  };
+
+  struct Stats {
+    uint32_t size { 0 };
+    uint32_t usedSize { 0 };
+    uint32_t freeSize { 0 };
+    uint32_t largestFreeBlock { 0 };
+    uint32_t freeBlockCount { 0 };
+    uint32_t allocationCount { 0 };
+    // 1 - (가장 큰 빈 블록 / 전체 빈 공간): 0이면 빈 공간이 한 덩어리
+    float fragmentation { 0.0f };
+  };
+
+  // maxAllocationCount: 동시에 존재할 수 있는 블록(할당 + 빈 블록) 수
+  OffsetAllocator(uint32_t size, uint32_t maxAllocationCount = 4096);
+
+  Allocation Allocate(uint32_t size);
+  // 이미 해제된 Allocation은 무시 (그 node가 다른 할당에 재사용됐어도 generation으로 구분)
+  void Free(const Allocation& allocation);
+  // 모든 할당을 버리고 처음 상태로
+  void Reset();
+  Stats GetStats() const;
+  uint32_t GetSize() const { return m_size; }
+
+private:
+  static constexpr uint32_t TOP_BIN_COUNT = 32;
+  static constexpr uint32_t BINS_PER_TOP = 8;
+  static constexpr uint32_t BIN_COUNT = TOP_BIN_COUNT * BINS_PER_TOP;
+
+  struct Node {
+    uint32_t offset { 0 };
+    uint32_t size { 0 };
+    // 같은 bin 안의 빈 블록 목록
+    uint32_t binPrev { INVALID };
+    uint32_t binNext { INVALID };
+    // 주소상 앞 / 뒤 블록
+    uint32_t neighborPrev { INVALID };
+    uint32_t neighborNext { INVALID };
+    bool used { false };
+    // 마지막으로 이 node를 할당했을 때의 번호
+    uint32_t generation { 0 };
+  };
+
+  uint32_t InsertFreeNode(uint32_t offset, uint32_t size);
+  void RemoveFreeNode(uint32_t nodeIndex);
+  void ReleaseNode(uint32_t nodeIndex);
+
+  uint32_t m_size { 0 };
+  uint32_t m_freeSize { 0 };
+  uint32_t m_freeBlockCount { 0 };
+  uint32_t m_allocationCount { 0 };
+  // 할당마다 증가 (Reset()해도 되돌리지 않아 이전 Allocation과 겹치지 않음)
+  uint32_t m_generation { 0 };
+
+  uint32_t m_topBinMask { 0 };
+  uint8_t m_binMasks[TOP_BIN_COUNT] {};
+  uint32_t m_binHeads[BIN_COUNT] {};
+
+  std::vector<Node> m_nodes;
+  // 사용하지 않는 node 번호 stack
+  std::vector<uint32_t> m_unusedNodes;
+};
+
+#endif // __OFFSET_ALLOCATOR_H__
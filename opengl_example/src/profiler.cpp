@@ -0,0 +1,238 @@
+#include "profiler.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cstring>
+
+ProfilerUPtr Profiler::Create() {
+  auto profiler = ProfilerUPtr(new Profiler());
+  if (!profiler->Init())
+    return nullptr;
+  return std::move(profiler);
+}
+
+Profiler::~Profiler() {
+  glDeleteQueries(FRAME_LATENCY * MAX_SCOPES_PER_FRAME * 2, &m_queries[0][0]);
+}
+
+bool Profiler::Init() {
+  glGenQueries(FRAME_LATENCY * MAX_SCOPES_PER_FRAME * 2, &m_queries[0][0]);
+  return true;
+}
+
+void Profiler::History::Push(float value) {
+  values[offset] = value;
+  offset = (offset + 1) % HISTORY_SIZE;
+  count = std::min(count + 1, HISTORY_SIZE);
+}
+
+float Profiler::History::GetMean() const {
+  float sum = 0.0f;
+  for (int i = 0; i < count; i++)
+    sum += values[i];
+  return count > 0 ? sum / (float)count : 0.0f;
+}
+
+float Profiler::History::GetMax() const {
+  float maxValue = 0.0f;
+  for (int i = 0; i < count; i++)
+    maxValue = std::max(maxValue, values[i]);
+  return maxValue;
+}
+
+// 처음 보는 이름이면 새 scope로 등록 (등록 시점의 중첩 깊이를 기억해서 UI 들여쓰기에 사용)
+int Profiler::FindScope(const char* name) {
+  for (int i = 0; i < m_scopeCount; i++) {
+    if (m_scopes[i].name == name || strcmp(m_scopes[i].name, name) == 0)
+      return i;
+  }
+  if (m_scopeCount >= MAX_SCOPE_COUNT) {
+    SPDLOG_ERROR("too many profiler scopes: {}", name);
+    return -1;
+  }
+  auto& scope = m_scopes[m_scopeCount];
+  scope.name = name;
+  scope.depth = m_openScopeCount;
+  return m_scopeCount++;
+}
+
+/*
+glQueryCounter(query, GL_TIMESTAMP): 앞의 GL 명령들이 GPU에서 끝난 시점의 시각(ns)을 기록
+  - glBeginQuery(GL_TIME_ELAPSED)와 달리 중첩 / 다른 elapsed query(FrameBenchmark)와 겹쳐도 된다
+  - scope 시간 = 끝 timestamp - 시작 timestamp
+*/
+int Profiler::BeginScope(const char* name) {
+  int scopeIndex = FindScope(name);
+  if (scopeIndex < 0 || m_openScopeCount >= MAX_SCOPE_COUNT)
+    return -1;
+
+  auto& frame = m_frames[m_frameIndex % FRAME_LATENCY];
+  int queryIndex = -1;
+  if (frame.count < MAX_SCOPES_PER_FRAME) {
+    queryIndex = frame.count++;
+    auto& query = frame.queries[queryIndex];
+    query.scopeIndex = scopeIndex;
+    query.beginQuery = m_queries[m_frameIndex % FRAME_LATENCY][queryIndex * 2];
+    query.endQuery = m_queries[m_frameIndex % FRAME_LATENCY][queryIndex * 2 + 1];
+    glQueryCounter(query.beginQuery, GL_TIMESTAMP);
+  }
+
+  m_openScopes[m_openScopeCount++] = {
+    scopeIndex, queryIndex, std::chrono::high_resolution_clock::now() };
+  return scopeIndex;
+}
+
+void Profiler::EndScope(int scopeIndex) {
+  if (scopeIndex < 0 || m_openScopeCount == 0)
+    return;
+  auto& open = m_openScopes[--m_openScopeCount];
+  if (open.scopeIndex != scopeIndex) {
+    SPDLOG_ERROR("profiler scope mismatch: {}", m_scopes[scopeIndex].name);
+    return;
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  auto& scope = m_scopes[scopeIndex];
+  scope.cpuTime += std::chrono::duration<double, std::milli>(end - open.start).count();
+  scope.used = true;
+  if (open.queryIndex >= 0) {
+    auto& frame = m_frames[m_frameIndex % FRAME_LATENCY];
+    glQueryCounter(frame.queries[open.queryIndex].endQuery, GL_TIMESTAMP);
+  }
+}
+
+// 이번 프레임에 다시 쓸 query slot이 아직 GPU에서 끝나지 않았으면 기다리지 않고 버린다
+void Profiler::BeginFrame() {
+  for (int i = 1; i <= FRAME_LATENCY; i++) {
+    int slot = (m_frameIndex + i) % FRAME_LATENCY;
+    if (m_frames[slot].pending)
+      CollectQueries(slot, false);
+  }
+
+  int slot = m_frameIndex % FRAME_LATENCY;
+  auto& frame = m_frames[slot];
+  if (frame.pending) {
+    frame.pending = false;
+    m_droppedFrameCount++;
+  }
+  frame.count = 0;
+
+  for (int i = 0; i < m_scopeCount; i++) {
+    m_scopes[i].cpuTime = 0.0;
+    m_scopes[i].used = false;
+  }
+}
+
+void Profiler::EndFrame() {
+  for (int i = 0; i < m_scopeCount; i++) {
+    auto& scope = m_scopes[i];
+    if (scope.used)
+      scope.cpuHistory.Push((float)scope.cpuTime);
+  }
+  auto& frame = m_frames[m_frameIndex % FRAME_LATENCY];
+  frame.pending = frame.count > 0;
+  m_frameIndex++;
+}
+
+void Profiler::Finish() {
+  // 오래된 프레임부터 순서대로 회수
+  for (int i = 0; i < FRAME_LATENCY; i++) {
+    int slot = (m_frameIndex + i) % FRAME_LATENCY;
+    if (m_frames[slot].pending)
+      CollectQueries(slot, true);
+  }
+}
+
+/*
+GL_QUERY_RESULT_AVAILABLE: 결과가 준비되었는지 확인 (기다리지 않음)
+query는 기록된 순서대로 끝나므로 프레임의 마지막 query만 확인하면 된다
+*/
+bool Profiler::CollectQueries(int slot, bool wait) {
+  auto& frame = m_frames[slot];
+  if (!wait) {
+    int available = 0;
+    glGetQueryObjectiv(frame.queries[frame.count - 1].endQuery,
+      GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+      return false;
+  }
+
+  double gpuTimes[MAX_SCOPE_COUNT] = {};
+  bool used[MAX_SCOPE_COUNT] = {};
+  for (int i = 0; i < frame.count; i++) {
+    const auto& query = frame.queries[i];
+    GLuint64 begin = 0;
+    GLuint64 end = 0;
+    glGetQueryObjectui64v(query.beginQuery, GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(query.endQuery, GL_QUERY_RESULT, &end);
+    gpuTimes[query.scopeIndex] += end > begin ? (double)(end - begin) / 1000000.0 : 0.0;
+    used[query.scopeIndex] = true;
+  }
+  for (int i = 0; i < m_scopeCount; i++) {
+    if (used[i])
+      m_scopes[i].gpuHistory.Push((float)gpuTimes[i]);
+  }
+  frame.pending = false;
+  return true;
+}
+
+// History는 ring buffer: 가득 찼으면 offset이 가장 오래된 값의 위치
+static int GetPlotOffset(int offset, int count, int size) {
+  return count == size ? offset : 0;
+}
+
+void Profiler::DrawImGui() const {
+  ImGui::Text("history: %d frames, dropped gpu frames: %d",
+    HISTORY_SIZE, (int)m_droppedFrameCount);
+  for (int i = 0; i < m_scopeCount; i++) {
+    const auto& scope = m_scopes[i];
+    float indent = 10.0f * (float)scope.depth;
+    if (indent > 0.0f)
+      ImGui::Indent(indent);
+    ImGui::PushID(i);
+    ImGui::Text("%s  cpu %.3f ms, gpu %.3f ms", scope.name,
+      scope.cpuHistory.GetMean(), scope.gpuHistory.GetMean());
+    const auto& cpu = scope.cpuHistory;
+    ImGui::PlotLines("##cpu", cpu.values, cpu.count,
+      GetPlotOffset(cpu.offset, cpu.count, HISTORY_SIZE), "cpu",
+      0.0f, std::max(cpu.GetMax(), 0.001f), ImVec2(0.0f, 30.0f));
+    const auto& gpu = scope.gpuHistory;
+    ImGui::PlotLines("##gpu", gpu.values, gpu.count,
+      GetPlotOffset(gpu.offset, gpu.count, HISTORY_SIZE), "gpu",
+      0.0f, std::max(gpu.GetMax(), 0.001f), ImVec2(0.0f, 30.0f));
+    ImGui::PopID();
+    if (indent > 0.0f)
+      ImGui::Unindent(indent);
+  }
+}
+
+static std::string HistoryToJson(const float* values, int offset, int count, int size,
+  float mean, float maxValue) {
+  std::string json = fmt::format(
+    "{{\"mean\": {:.4f}, \"max\": {:.4f}, \"history\": [", mean, maxValue);
+  int start = GetPlotOffset(offset, count, size);
+  for (int i = 0; i < count; i++) {
+    if (i > 0)
+      json += ", ";
+    json += fmt::format("{:.4f}", values[(start + i) % size]);
+  }
+  json += "]}";
+  return json;
+}
+
+std::string Profiler::ToJson() const {
+  std::string json = fmt::format(
+    "{{\"frames\": {}, \"dropped_gpu_frames\": {}, \"scopes\": [",
+    m_frameIndex, m_droppedFrameCount);
+  for (int i = 0; i < m_scopeCount; i++) {
+    const auto& scope = m_scopes[i];
+    const auto& cpu = scope.cpuHistory;
+    const auto& gpu = scope.gpuHistory;
+    if (i > 0)
+      json += ", ";
+    json += fmt::format("{{\"name\": \"{}\", \"depth\": {}, \"cpu_ms\": {}, \"gpu_ms\": {}}}",
+      scope.name, scope.depth,
+      HistoryToJson(cpu.values, cpu.offset, cpu.count, HISTORY_SIZE, cpu.GetMean(), cpu.GetMax()),
+      HistoryToJson(gpu.values, gpu.offset, gpu.count, HISTORY_SIZE, gpu.GetMean(), gpu.GetMax()));
+  }
+  json += "]}";
+  return json;
+}
@@ -0,0 +1,115 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "common.h"
+#include <chrono>
+
+/*
+** CPU / GPU scope profiler
+  이름 붙은 구간(scope)마다 CPU 시간과 GPU 시간을 측정해서 최근 HISTORY_SIZE 프레임을 보관
+  - GPU: 구간 시작/끝에 GL_TIMESTAMP query를 기록 (GL_TIME_ELAPSED는 중첩할 수 없으므로)
+  - query 결과는 FRAME_LATENCY 프레임 뒤에 준비된 것만 읽고, 준비가 안 되었으면 버림
+    -> 결과를 기다리느라 CPU가 멈추지 않는다
+  - 같은 scope가 한 프레임에 여러 번 열리면 시간을 합산
+*/
+CLASS_PTR(Profiler)
+class Profiler {
+public:
+  static constexpr int MAX_SCOPE_COUNT = 16;
+  static constexpr int HISTORY_SIZE = 120;
+
+  static ProfilerUPtr Create();
+  ~Profiler();
+
+  void BeginFrame();
+  void EndFrame();
+  // 아직 읽지 않은 GPU 결과를 기다려서 모두 회수 (종료 전 JSON 출력용)
+  void Finish();
+  // name은 프로그램이 끝날 때까지 유효한 문자열이어야 한다 (문자열 상수)
+  int BeginScope(const char* name);
+  void EndScope(int scopeIndex);
+
+  // ui window 안에서 호출: scope 별 최근 CPU/GPU 시간 그래프
+  void DrawImGui() const;
+  std::string ToJson() const;
+
+private:
+  Profiler() {}
+  bool Init();
+  int FindScope(const char* name);
+  // wait가 false면 결과가 준비된 경우에만 읽고 true 반환
+  bool CollectQueries(int slot, bool wait);
+
+  // GPU 결과를 읽기 전까지 돌려 쓰는 프레임 수
+  static constexpr int FRAME_LATENCY = 4;
+  // 한 프레임에 열 수 있는 scope 수 (query 쌍 개수)
+  static constexpr int MAX_SCOPES_PER_FRAME = 32;
+
+  struct History {
+    float values[HISTORY_SIZE] {};
+    int offset { 0 };
+    int count { 0 };
+
+    void Push(float value);
+    float GetMean() const;
+    float GetMax() const;
+  };
+
+  struct Scope {
+    const char* name { nullptr };
+    int depth { 0 };
+    double cpuTime { 0.0 };
+    bool used { false };
+    History cpuHistory;
+    History gpuHistory;
+  };
+
+  struct ScopeQuery {
+    int scopeIndex;
+    uint32_t beginQuery;
+    uint32_t endQuery;
+  };
+
+  struct FrameQueries {
+    ScopeQuery queries[MAX_SCOPES_PER_FRAME];
+    int count { 0 };
+    bool pending { false };
+  };
+
+  Scope m_scopes[MAX_SCOPE_COUNT];
+  int m_scopeCount { 0 };
+
+  // 열려 있는 scope stack (깊이 표시와 CPU 시간 측정용)
+  struct OpenScope {
+    int scopeIndex;
+    int queryIndex;
+    std::chrono::high_resolution_clock::time_point start;
+  };
+  OpenScope m_openScopes[MAX_SCOPE_COUNT];
+  int m_openScopeCount { 0 };
+
+  uint32_t m_queries[FRAME_LATENCY][MAX_SCOPES_PER_FRAME * 2] {};
+  FrameQueries m_frames[FRAME_LATENCY];
+  int m_frameIndex { 0 };
+  uint64_t m_droppedFrameCount { 0 };
+};
+
+// 생성부터 소멸까지를 하나의 scope로 측정 (profiler가 nullptr이면 아무것도 하지 않음)
+class ProfileScope {
+public:
+  ProfileScope(Profiler* profiler, const char* name)
+    : m_profiler(profiler),
+      m_scopeIndex(profiler ? profiler->BeginScope(name) : -1) {}
+  ~ProfileScope() {
+    if (m_profiler)
+      m_profiler->EndScope(m_scopeIndex);
+  }
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  Profiler* m_profiler;
+  int m_scopeIndex;
+};
+
+#endif // __PROFILER_H__
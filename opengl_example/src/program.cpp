@@ -1,4 +1,7 @@
 #include "program.h"
+#include "frame_uniforms.h"
+#include "gl_state.h"
+#include <algorithm>
 
 ProgramUPtr Program::Create(const std::vector<ShaderPtr>& shaders) {
   auto program = ProgramUPtr(new Program());
@@ -21,6 +24,7 @@ ProgramUPtr Program::Create(
 Program::~Program() {
   if (m_program) {
     glDeleteProgram(m_program);
+    GLState::ForgetProgram(m_program);
   }
 }
 
@@ -46,11 +50,77 @@ bool Program::Link(const std::vector<ShaderPtr>& shaders) {
     SPDLOG_ERROR("failed to link program: {}", infoLog);
     return false;
   }
+  if (!BindFrameUniformBlock(m_program))
+    return false;
+  return ReflectUniforms();
+}
+
+/*
+glGetProgramiv(GL_ACTIVE_UNIFORMS): 링크된 program이 실제로 사용하는 uniform 개수
+glGetActiveUniform(): i번째 uniform의 이름, 타입, 배열 크기
+  - 배열 uniform은 "name[0]" 형태로 하나만 나오므로 "name"과 각 원소 "name[i]"를 모두 등록
+  - 원소의 location이 연속이라는 보장은 없으므로 원소마다 glGetUniformLocation()으로 얻음
+*/
+bool Program::ReflectUniforms() {
+  int uniformCount = 0;
+  int maxNameLength = 0;
+  glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &uniformCount);
+  glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+  // hash 충돌을 이름으로 알릴 수 있도록 이름과 같이 모은 뒤 table로 옮김
+  struct ReflectedUniform {
+    uint32_t hash;
+    int32_t location;
+    std::string name;
+  };
+  std::vector<ReflectedUniform> uniforms;
+  uniforms.reserve(uniformCount);
+  std::vector<char> nameBuffer(std::max(maxNameLength, 1));
+  auto addUniform = [&](std::string name, int32_t location) {
+    uint32_t hash = HashUniformName(name.c_str(), name.size());
+    uniforms.push_back({ hash, location, std::move(name) });
+  };
+  for (int i = 0; i < uniformCount; i++) {
+    int length = 0;
+    int size = 0;
+    GLenum type = 0;
+    glGetActiveUniform(m_program, i, (GLsizei)nameBuffer.size(),
+      &length, &size, &type, nameBuffer.data());
+    int32_t location = glGetUniformLocation(m_program, nameBuffer.data());
+    if (location < 0) // uniform block 멤버
+      continue;
+    std::string name(nameBuffer.data(), length);
+    if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+      name.resize(name.size() - 3);
+      addUniform(name, location);
+      for (int element = 0; element < size; element++) {
+        auto elementName = fmt::format("{}[{}]", name, element);
+        addUniform(elementName, glGetUniformLocation(m_program, elementName.c_str()));
+      }
+    }
+    else {
+      addUniform(name, location);
+    }
+  }
+
+  std::sort(uniforms.begin(), uniforms.end(),
+    [](const ReflectedUniform& a, const ReflectedUniform& b) { return a.hash < b.hash; });
+  for (size_t i = 1; i < uniforms.size(); i++) {
+    if (uniforms[i - 1].hash == uniforms[i].hash) {
+      SPDLOG_ERROR("uniform name hash collision: {} and {} (0x{:08x})",
+        uniforms[i - 1].name, uniforms[i].name, uniforms[i].hash);
+      return false;
+    }
+  }
+  m_uniforms.clear();
+  m_uniforms.reserve(uniforms.size());
+  for (const auto& uniform : uniforms)
+    m_uniforms.push_back({ uniform.hash, uniform.location });
   return true;
 }
 
 void Program::Use() const {
-  glUseProgram(m_program);
+  GLState::UseProgram(m_program);
 }
 
 void Program::SetUniform(const std::string& name, int value) const {
@@ -73,7 +143,44 @@ void Program::SetUniform(const std::string& name, const glm::vec4& value) const
   glUniform4fv(loc, 1, glm::value_ptr(value));
 }
 
+void Program::SetUniform(const std::string& name, const glm::mat3& value) const {
+  auto loc = glGetUniformLocation(m_program, name.c_str());
+  glUniformMatrix3fv(loc, 1, GL_FALSE, glm::value_ptr(value));
+}
+
 void Program::SetUniform(const std::string& name, const glm::mat4& value) const {
   auto loc = glGetUniformLocation(m_program, name.c_str());
   glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+int32_t Program::GetUniformLocation(UniformName name) const {
+  auto it = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), name.GetHash(),
+    [](const UniformLocation& uniform, uint32_t hash) { return uniform.hash < hash; });
+  if (it == m_uniforms.end() || it->hash != name.GetHash())
+    return -1;
+  return it->location;
+}
+
+void Program::SetUniform(UniformName name, int value) const {
+  glUniform1i(GetUniformLocation(name), value);
+}
+
+void Program::SetUniform(UniformName name, float value) const {
+  glUniform1f(GetUniformLocation(name), value);
+}
+
+void Program::SetUniform(UniformName name, const glm::vec3& value) const {
+  glUniform3fv(GetUniformLocation(name), 1, glm::value_ptr(value));
+}
+
+void Program::SetUniform(UniformName name, const glm::vec4& value) const {
+  glUniform4fv(GetUniformLocation(name), 1, glm::value_ptr(value));
+}
+
+void Program::SetUniform(UniformName name, const glm::mat3& value) const {
+  glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Program::SetUniform(UniformName name, const glm::mat4& value) const {
+  glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
 }
\ No newline at end of file
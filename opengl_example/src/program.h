@@ -3,6 +3,36 @@
 
 #include "common.h"
 #include "shader.h"
+#include <vector>
+
+// uniform 이름의 FNV-1a hash
+// link 시점에는 reflection으로 얻은 이름에 대해 runtime에 계산
+constexpr uint32_t HashUniformName(const char* name, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= (uint8_t)name[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// std::string을 만들지 않고 uniform을 찾기 위한 이름 key
+// ex) m_program->SetUniform("material.shininess"_uniform, 32.0f);
+class UniformName {
+public:
+  constexpr UniformName(const char* name, size_t length)
+    : m_name(name), m_hash(HashUniformName(name, length)) {}
+  constexpr const char* GetName() const { return m_name; }
+  constexpr uint32_t GetHash() const { return m_hash; }
+private:
+  const char* m_name;
+  uint32_t m_hash;
+};
+
+// consteval: "..."_uniform의 hash는 항상 컴파일 타임에 계산됨 (runtime 비용 없음)
+consteval UniformName operator""_uniform(const char* name, size_t length) {
+  return UniformName(name, length);
+}
 
 CLASS_PTR(Program)
 class Program {
@@ -22,11 +52,30 @@ public:
   void SetUniform(const std::string& name, float value) const;
   void SetUniform(const std::string& name, const glm::vec3& value) const;
   void SetUniform(const std::string& name, const glm::vec4& value) const;
+  void SetUniform(const std::string& name, const glm::mat3& value) const;
   void SetUniform(const std::string& name, const glm::mat4& value) const;
+
+  // Link 시점에 만들어 둔 table에서 location을 찾음 (할당, GL 호출 없음)
+  // 존재하지 않는 uniform이면 -1 (glUniform*이 무시하는 값)
+  int32_t GetUniformLocation(UniformName name) const;
+  void SetUniform(UniformName name, int value) const;
+  void SetUniform(UniformName name, float value) const;
+  void SetUniform(UniformName name, const glm::vec3& value) const;
+  void SetUniform(UniformName name, const glm::vec4& value) const;
+  void SetUniform(UniformName name, const glm::mat3& value) const;
+  void SetUniform(UniformName name, const glm::mat4& value) const;
 private:
   Program() {}
   bool Link(const std::vector<ShaderPtr>& shaders);
+  bool ReflectUniforms();
   uint32_t m_program { 0 };
+
+  // 이름 hash 순으로 정렬된 uniform location table
+  struct UniformLocation {
+    uint32_t hash;
+    int32_t location;
+  };
+  std::vector<UniformLocation> m_uniforms;
 };
 
 
@@ -0,0 +1,258 @@
+#include "render_queue.h"
+#include "gl_state.h"
+#include <algorithm>
+#include <cstring>
+
+/*
+64bit sort key 구성
+  opaque      : [63:62] pass | [61:52] program | [51:40] material | [39:28] mesh | [27:4] depth
+  transparent : [63:62] pass | [61:38] ~depth  | [37:28] program  | [27:16] material
+  - opaque는 mesh(VAO, index 범위)를 depth보다 위에 두어 같은 batch의 item이 흩어지지 않게 함
+    (depth는 같은 batch 안에서의 앞 -> 뒤 순서로만 쓰임)
+  - 남는 하위 bit는 비워둠 (radix sort에서 값이 모두 같은 자리는 건너뛰므로 비용 없음)
+*/
+static constexpr int PROGRAM_ID_BITS = 10;
+static constexpr int MATERIAL_ID_BITS = 12;
+static constexpr int MESH_ID_BITS = 12;
+static constexpr int DEPTH_BITS = 24;
+static constexpr uint32_t DEPTH_MASK = (1u << DEPTH_BITS) - 1;
+
+// 양수 float의 bit 패턴은 값의 크기 순서와 같으므로 상위 bit만 잘라서 정수로 비교
+static uint32_t QuantizeDepth(float depth) {
+  if (!(depth > 0.0f))
+    return 0;
+  uint32_t bits;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  // 부호 bit를 뺀 31bit 중 상위 24bit
+  return (bits >> (31 - DEPTH_BITS)) & DEPTH_MASK;
+}
+
+static uint64_t MakeSortKey(RenderPass pass, uint32_t programId,
+  uint32_t materialId, uint32_t meshId, float depth) {
+  uint64_t key = (uint64_t)pass << 62;
+  uint64_t depthBits = QuantizeDepth(depth);
+  if (pass == RenderPass::Opaque) {
+    key |= (uint64_t)programId << 52;
+    key |= (uint64_t)materialId << 40;
+    key |= (uint64_t)meshId << 28;
+    key |= depthBits << 4;
+  }
+  else {
+    key |= (uint64_t)(~depthBits & DEPTH_MASK) << 38;
+    key |= (uint64_t)programId << 28;
+    key |= (uint64_t)materialId << 16;
+  }
+  return key;
+}
+
+RenderQueueUPtr RenderQueue::Create(size_t capacity) {
+  auto renderQueue = RenderQueueUPtr(new RenderQueue());
+  renderQueue->Init(capacity);
+  return std::move(renderQueue);
+}
+
+void RenderQueue::Init(size_t capacity) {
+  m_items.reserve(capacity);
+  m_sortEntries.reserve(capacity);
+  m_sortScratch.reserve(capacity);
+  m_batches.reserve(capacity);
+  m_batchTransformIndices.reserve(capacity);
+}
+
+void RenderQueue::Clear() {
+  m_items.clear();
+  m_sortEntries.clear();
+  // id는 한 프레임 안에서만 의미가 있음 (지워진 program / texture의 주소가 쌓이지 않게)
+  m_programs.clear();
+  m_materials.clear();
+  m_meshes.clear();
+}
+
+void RenderQueue::Submit(const DrawItem& item) {
+  // 반투명은 depth 순서가 우선이므로 mesh id를 쓰지 않음
+  uint32_t meshId = item.pass == RenderPass::Opaque ? GetMeshId(item) : 0;
+  uint64_t key = MakeSortKey(item.pass, GetProgramId(item.program),
+    GetMaterialId(item), meshId, item.depth);
+  m_sortEntries.push_back({ key, (uint32_t)m_items.size() });
+  m_items.push_back(item);
+}
+
+// program / material 종류는 몇 개 안 되므로 선형 탐색 (직전 결과부터 확인)
+uint32_t RenderQueue::GetProgramId(const Program* program) {
+  for (size_t i = m_programs.size(); i > 0; i--) {
+    if (m_programs[i - 1] == program)
+      return (uint32_t)i;
+  }
+  if (m_programs.size() + 1 >= (1u << PROGRAM_ID_BITS)) {
+    SPDLOG_ERROR("too many programs in render queue");
+    return 0;
+  }
+  m_programs.push_back(program);
+  return (uint32_t)m_programs.size();
+}
+
+uint32_t RenderQueue::GetMaterialId(const DrawItem& item) {
+  const auto textureCount = DrawItem::MAX_TEXTURE_COUNT;
+  bool hasTexture = false;
+  for (auto texture : item.textures)
+    hasTexture |= texture != nullptr;
+  if (!hasTexture)
+    return 0;
+
+  size_t materialCount = m_materials.size() / textureCount;
+  for (size_t i = materialCount; i > 0; i--) {
+    auto textures = m_materials.data() + (i - 1) * textureCount;
+    if (std::equal(textures, textures + textureCount, item.textures))
+      return (uint32_t)i;
+  }
+  if (materialCount + 1 >= (1u << MATERIAL_ID_BITS)) {
+    SPDLOG_ERROR("too many materials in render queue");
+    return 0;
+  }
+  m_materials.insert(m_materials.end(), item.textures, item.textures + textureCount);
+  return (uint32_t)materialCount + 1;
+}
+
+// mesh는 IsSameBatch()에서 비교하는 VAO, draw 방식, index 범위의 조합
+// (그 mesh를 처음 쓴 item의 m_items 번호로 기억, submit 전에 호출되므로 새 item은 m_items.size())
+uint32_t RenderQueue::GetMeshId(const DrawItem& item) {
+  for (size_t i = m_meshes.size(); i > 0; i--) {
+    const auto& mesh = m_items[m_meshes[i - 1]];
+    if (mesh.vertexLayout == item.vertexLayout && mesh.drawKind == item.drawKind &&
+      mesh.firstIndex == item.firstIndex && mesh.indexCount == item.indexCount &&
+      mesh.baseVertex == item.baseVertex)
+      return (uint32_t)i;
+  }
+  if (m_meshes.size() + 1 >= (1u << MESH_ID_BITS)) {
+    SPDLOG_ERROR("too many meshes in render queue");
+    return 0;
+  }
+  m_meshes.push_back((uint32_t)m_items.size());
+  return (uint32_t)m_meshes.size();
+}
+
+/*
+LSD radix sort (8bit씩 8번)
+  - 자리 별 histogram을 한 번의 순회로 모두 구함
+  - 모든 key가 같은 값을 갖는 자리는 (pass, 하위 비트 등) 건너뜀
+  - stable 하므로 key가 같으면 submit 순서가 유지된다
+*/
+void RenderQueue::Sort() {
+  size_t count = m_sortEntries.size();
+  if (count < 2)
+    return;
+
+  uint32_t histograms[8][256] = {};
+  for (const auto& entry : m_sortEntries) {
+    for (int digit = 0; digit < 8; digit++)
+      histograms[digit][(entry.key >> (digit * 8)) & 0xFF]++;
+  }
+
+  m_sortScratch.resize(count);
+  for (int digit = 0; digit < 8; digit++) {
+    auto& histogram = histograms[digit];
+    uint8_t firstValue = (m_sortEntries[0].key >> (digit * 8)) & 0xFF;
+    if (histogram[firstValue] == count)
+      continue;
+
+    uint32_t offset = 0;
+    for (auto& bucket : histogram) {
+      uint32_t bucketCount = bucket;
+      bucket = offset;
+      offset += bucketCount;
+    }
+    for (const auto& entry : m_sortEntries)
+      m_sortScratch[histogram[(entry.key >> (digit * 8)) & 0xFF]++] = entry;
+    m_sortEntries.swap(m_sortScratch);
+  }
+}
+
+// program, material, VAO가 같으면 state 변경 없이 이어서 그릴 수 있음
+static bool IsSameState(const DrawItem& a, const DrawItem& b) {
+  return a.pass == b.pass &&
+    a.program == b.program &&
+    std::equal(a.textures, a.textures + DrawItem::MAX_TEXTURE_COUNT, b.textures) &&
+    a.vertexLayout == b.vertexLayout &&
+    a.drawKind == b.drawKind;
+}
+
+static bool IsSameBatch(const DrawItem& a, const DrawItem& b) {
+  return IsSameState(a, b) &&
+    a.firstIndex == b.firstIndex &&
+    a.indexCount == b.indexCount &&
+    a.baseVertex == b.baseVertex;
+}
+
+/*
+정렬된 순서대로 같은 batch에 속한 item을 모은 뒤
+state가 같은 연속된 batch마다 바뀐 state만 설정하고 drawBatch(또는 multiDraw)를 호출
+(중복 호출은 GLState가 한 번 더 걸러냄)
+반투명 pass에 들어가면 blending을 켜고 depth write를 끈다
+*/
+void RenderQueue::Execute(const DrawBatchFunc& drawBatch, const MultiDrawFunc& multiDraw) {
+  Sort();
+
+  m_programChangeCount = 0;
+  m_materialChangeCount = 0;
+
+  // transform index는 정렬된 순서 그대로 이어 붙이고 batch는 그 안의 범위를 가리킴
+  m_batches.clear();
+  m_batchTransformIndices.clear();
+  for (size_t i = 0; i < m_sortEntries.size(); i++) {
+    const auto& item = m_items[m_sortEntries[i].itemIndex];
+    if (m_batches.empty() || !IsSameBatch(*m_batches.back().item, item))
+      m_batches.push_back({ &item, (uint32_t)i, 0 });
+    m_batches.back().transformCount++;
+    m_batchTransformIndices.push_back(item.transformIndex);
+  }
+  m_batchCount = m_batches.size();
+
+  const DrawItem* prev = nullptr;
+  bool transparent = false;
+  size_t begin = 0;
+  while (begin < m_batches.size()) {
+    const auto& item = *m_batches[begin].item;
+    size_t end = begin + 1;
+    while (end < m_batches.size() && IsSameState(item, *m_batches[end].item))
+      end++;
+
+    if (item.pass == RenderPass::Transparent && !transparent) {
+      transparent = true;
+      GLState::Enable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glDepthMask(GL_FALSE);
+    }
+    if (!prev || prev->program != item.program) {
+      item.program->Use();
+      m_programChangeCount++;
+    }
+    if (!prev || !std::equal(prev->textures,
+        prev->textures + DrawItem::MAX_TEXTURE_COUNT, item.textures)) {
+      for (int i = 0; i < DrawItem::MAX_TEXTURE_COUNT; i++) {
+        if (item.textures[i])
+          item.textures[i]->Bind(i);
+      }
+      m_materialChangeCount++;
+    }
+    if (!prev || prev->vertexLayout != item.vertexLayout)
+      item.vertexLayout->Bind();
+
+    if (multiDraw) {
+      multiDraw(m_batches.data() + begin, end - begin, m_batchTransformIndices.data());
+    }
+    else {
+      for (size_t i = begin; i < end; i++) {
+        const auto& batch = m_batches[i];
+        drawBatch(*batch.item, m_batchTransformIndices.data() + batch.firstTransform,
+          batch.transformCount);
+      }
+    }
+    prev = &item;
+    begin = end;
+  }
+
+  if (transparent) {
+    glDepthMask(GL_TRUE);
+    GLState::Disable(GL_BLEND);
+  }
+}
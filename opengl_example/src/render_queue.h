@@ -0,0 +1,107 @@
+#ifndef __RENDER_QUEUE_H__
+#define __RENDER_QUEUE_H__
+
+#include "common.h"
+#include "program.h"
+#include "texture.h"
+#include "vertex_layout.h"
+#include <vector>
+#include <functional>
+
+/*
+** Render queue
+  바로 그리지 않고 draw item을 모아서 64bit sort key로 정렬한 뒤 한 번에 실행
+  - 불투명(opaque): pass | program | material | mesh | depth (같은 mesh 안에서 앞 -> 뒤, early-z 활용)
+  - 반투명(transparent): pass | 뒤집은 depth | program | material (뒤 -> 앞, blending 순서)
+  - 정렬 후 program, material, VAO, index 범위가 같은 연속된 item은 하나의 batch로 묶어서
+    state 변경 없이 그린다 (instancing이면 draw call도 하나)
+  - index 범위만 다른 연속된 batch(다른 mesh, LOD)는 state가 같으므로 한 번에 넘길 수 있음
+    (multi draw indirect로 draw call 하나)
+*/
+enum class RenderPass : uint8_t {
+  Opaque = 0,
+  Transparent = 1,
+};
+
+struct DrawItem {
+  static constexpr int MAX_TEXTURE_COUNT = 2;
+
+  RenderPass pass { RenderPass::Opaque };
+  const Program* program { nullptr };
+  // texture unit 0, 1, ...에 바인딩할 material texture (없으면 nullptr)
+  const Texture* textures[MAX_TEXTURE_COUNT] {};
+  const VertexLayout* vertexLayout { nullptr };
+  uint32_t firstIndex { 0 };
+  uint32_t indexCount { 0 };
+  // 인덱스에 더해지는 정점 offset (여러 mesh가 한 vertex buffer를 공유할 때)
+  int32_t baseVertex { 0 };
+  // view space에서 카메라까지의 거리
+  float depth { 0.0f };
+  // 호출한 쪽이 transform 등을 찾을 때 쓰는 index (queue는 해석하지 않음)
+  uint32_t transformIndex { 0 };
+  // 호출한 쪽이 batch를 그리는 방법을 고를 때 쓰는 값 (queue는 같은 batch인지 비교만 함)
+  uint8_t drawKind { 0 };
+};
+
+CLASS_PTR(RenderQueue)
+class RenderQueue {
+public:
+  // batch 하나를 그리는 함수: state(program, texture, VAO)는 이미 설정된 상태로 호출되며
+  // batch에 속한 item들의 transformIndex가 정렬된 순서로 넘어온다
+  using DrawBatchFunc = std::function<void(const DrawItem& item,
+    const uint32_t* transformIndices, size_t count)>;
+
+  // batch 하나: item은 대표 item, transform index는 정렬된 전체 목록의 [first, first + count)
+  struct Batch {
+    const DrawItem* item { nullptr };
+    uint32_t firstTransform { 0 };
+    uint32_t transformCount { 0 };
+  };
+  // state가 같은 연속된 batch들을 한 번에 그리는 함수 (transformIndices는 정렬된 전체 목록)
+  using MultiDrawFunc = std::function<void(const Batch* batches, size_t batchCount,
+    const uint32_t* transformIndices)>;
+
+  static RenderQueueUPtr Create(size_t capacity);
+
+  void Clear();
+  void Submit(const DrawItem& item);
+  // multiDraw가 있으면 state가 같은 batch 묶음마다 multiDraw, 없으면 batch마다 drawBatch 호출
+  void Execute(const DrawBatchFunc& drawBatch, const MultiDrawFunc& multiDraw = nullptr);
+
+  size_t GetItemCount() const { return m_items.size(); }
+  // 지난 Execute()에서 만들어진 batch 수 / program, material이 바뀐 횟수
+  size_t GetBatchCount() const { return m_batchCount; }
+  size_t GetProgramChangeCount() const { return m_programChangeCount; }
+  size_t GetMaterialChangeCount() const { return m_materialChangeCount; }
+
+private:
+  RenderQueue() {}
+  void Init(size_t capacity);
+  uint32_t GetProgramId(const Program* program);
+  uint32_t GetMaterialId(const DrawItem& item);
+  uint32_t GetMeshId(const DrawItem& item);
+  void Sort();
+
+  struct SortEntry {
+    uint64_t key;
+    uint32_t itemIndex;
+  };
+
+  std::vector<DrawItem> m_items;
+  std::vector<SortEntry> m_sortEntries;
+  std::vector<SortEntry> m_sortScratch;
+  std::vector<Batch> m_batches;
+  std::vector<uint32_t> m_batchTransformIndices;
+
+  // sort key에 넣을 작은 id (Clear() 이후 처음 본 순서대로 1, 2, ...; material 0은 texture 없음)
+  std::vector<const Program*> m_programs;
+  std::vector<const Texture*> m_materials;
+  // mesh id마다 그 mesh를 처음 쓴 item의 번호
+  std::vector<uint32_t> m_meshes;
+
+  size_t m_batchCount { 0 };
+  size_t m_programChangeCount { 0 };
+  size_t m_materialChangeCount { 0 };
+};
+
+#endif // __RENDER_QUEUE_H__
@@ -0,0 +1,228 @@
+#include "scene.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCENE_SSE
+#endif
+
+static bool IsUniformScale(const glm::vec3& scale) {
+  return scale.x == scale.y && scale.y == scale.z;
+}
+
+SceneUPtr Scene::Create(size_t capacity) {
+  auto scene = SceneUPtr(new Scene());
+  scene->Init(capacity);
+  return std::move(scene);
+}
+
+void Scene::Init(size_t capacity) {
+  m_positions.reserve(capacity);
+  m_rotationAxes.reserve(capacity);
+  m_rotationAngles.reserve(capacity);
+  m_rotationSpeeds.reserve(capacity);
+  m_scales.reserve(capacity);
+  m_localRadii.reserve(capacity);
+  m_transforms.reserve(capacity);
+  m_normalMatrices.reserve(capacity);
+  m_dirty.reserve(capacity);
+  m_updateIndices.reserve(capacity);
+  m_boundsX.reserve(capacity);
+  m_boundsY.reserve(capacity);
+  m_boundsZ.reserve(capacity);
+  m_boundsRadius.reserve(capacity);
+  m_lodLevels.reserve(capacity);
+  m_indexToId.reserve(capacity);
+  m_idToIndex.reserve(capacity);
+}
+
+uint32_t Scene::AddObject(const glm::vec3& position,
+  const glm::vec3& rotationAxis, float rotationAngle,
+  float rotationSpeed, const glm::vec3& scale, float boundingRadius) {
+
+  uint32_t id;
+  if (!m_freeIds.empty()) {
+    id = m_freeIds.back();
+    m_freeIds.pop_back();
+  }
+  else {
+    id = (uint32_t)m_idToIndex.size();
+    m_idToIndex.push_back(0);
+  }
+  m_idToIndex[id] = (uint32_t)m_positions.size();
+  m_indexToId.push_back(id);
+
+  m_positions.push_back(position);
+  m_rotationAxes.push_back(glm::normalize(rotationAxis));
+  m_rotationAngles.push_back(rotationAngle);
+  m_rotationSpeeds.push_back(rotationSpeed);
+  m_scales.push_back(scale);
+  m_localRadii.push_back(boundingRadius);
+  m_transforms.push_back(glm::mat4(1.0f));
+  m_normalMatrices.push_back(NormalMatrix());
+  m_dirty.push_back(1);
+  if (!IsUniformScale(scale))
+    m_nonUniformScaleCount++;
+  m_boundsX.push_back(position.x);
+  m_boundsY.push_back(position.y);
+  m_boundsZ.push_back(position.z);
+  m_boundsRadius.push_back(boundingRadius);
+  m_lodLevels.push_back(0);
+  return id;
+}
+
+void Scene::RemoveObject(uint32_t id) {
+  // 지워진 id의 m_idToIndex는 다른 object의 index를 가리킬 수 있으므로 역방향으로도 확인
+  if (id >= m_idToIndex.size() || m_idToIndex[id] >= m_indexToId.size() ||
+    m_indexToId[m_idToIndex[id]] != id) {
+    SPDLOG_ERROR("remove of unknown scene object id: {}", id);
+    return;
+  }
+  // 마지막 object를 지워질 자리로 옮긴 뒤 배열 끝을 제거
+  size_t index = m_idToIndex[id];
+  size_t last = m_positions.size() - 1;
+  if (!IsUniformScale(m_scales[index]))
+    m_nonUniformScaleCount--;
+  if (index != last) {
+    m_positions[index] = m_positions[last];
+    m_rotationAxes[index] = m_rotationAxes[last];
+    m_rotationAngles[index] = m_rotationAngles[last];
+    m_rotationSpeeds[index] = m_rotationSpeeds[last];
+    m_scales[index] = m_scales[last];
+    m_localRadii[index] = m_localRadii[last];
+    m_transforms[index] = m_transforms[last];
+    m_normalMatrices[index] = m_normalMatrices[last];
+    m_dirty[index] = m_dirty[last];
+    m_boundsX[index] = m_boundsX[last];
+    m_boundsY[index] = m_boundsY[last];
+    m_boundsZ[index] = m_boundsZ[last];
+    m_boundsRadius[index] = m_boundsRadius[last];
+    m_lodLevels[index] = m_lodLevels[last];
+    m_indexToId[index] = m_indexToId[last];
+    m_idToIndex[m_indexToId[index]] = (uint32_t)index;
+  }
+  m_positions.pop_back();
+  m_rotationAxes.pop_back();
+  m_rotationAngles.pop_back();
+  m_rotationSpeeds.pop_back();
+  m_scales.pop_back();
+  m_localRadii.pop_back();
+  m_transforms.pop_back();
+  m_normalMatrices.pop_back();
+  m_dirty.pop_back();
+  m_boundsX.pop_back();
+  m_boundsY.pop_back();
+  m_boundsZ.pop_back();
+  m_boundsRadius.pop_back();
+  m_lodLevels.pop_back();
+  m_indexToId.pop_back();
+  m_freeIds.push_back(id);
+}
+
+void Scene::SetPosition(uint32_t id, const glm::vec3& position) {
+  auto index = m_idToIndex[id];
+  m_positions[index] = position;
+  m_dirty[index] = 1;
+}
+
+void Scene::SetRotation(uint32_t id, const glm::vec3& axis, float angle) {
+  auto index = m_idToIndex[id];
+  m_rotationAxes[index] = glm::normalize(axis);
+  m_rotationAngles[index] = angle;
+  m_dirty[index] = 1;
+}
+
+void Scene::SetScale(uint32_t id, const glm::vec3& scale) {
+  auto index = m_idToIndex[id];
+  if (!IsUniformScale(m_scales[index]))
+    m_nonUniformScaleCount--;
+  if (!IsUniformScale(scale))
+    m_nonUniformScaleCount++;
+  m_scales[index] = scale;
+  m_dirty[index] = 1;
+}
+
+void Scene::Update(float time) {
+  bool timeChanged = time != m_time;
+  m_time = time;
+  m_updateIndices.clear();
+  for (size_t i = 0; i < m_positions.size(); i++) {
+    if (m_dirty[i] || (timeChanged && m_rotationSpeeds[i] != 0.0f)) {
+      m_updateIndices.push_back((uint32_t)i);
+      m_dirty[i] = 0;
+    }
+  }
+  for (auto index : m_updateIndices)
+    ComputeTransform(index);
+  ComputeNormalMatrices();
+  m_updatedCount = m_updateIndices.size();
+}
+
+/*
+translate * rotate * scale를 4x4 행렬 곱 없이 바로 구성
+  - 회전: 축 a, 각도 θ에 대한 Rodrigues 공식
+    R = cosθ I + (1 - cosθ) a aᵀ + sinθ [a]x
+  - 각 열에 scale을 곱하고 4번째 열에 위치를 넣는다
+*/
+void Scene::ComputeTransform(size_t index) {
+  const auto& axis = m_rotationAxes[index];
+  const auto& scale = m_scales[index];
+  float angle = glm::radians(m_rotationAngles[index] + m_rotationSpeeds[index] * m_time);
+  float c = cosf(angle);
+  float s = sinf(angle);
+  float t = 1.0f - c;
+
+  auto& m = m_transforms[index];
+  m[0] = glm::vec4(
+    t * axis.x * axis.x + c,
+    t * axis.x * axis.y + s * axis.z,
+    t * axis.x * axis.z - s * axis.y, 0.0f) * scale.x;
+  m[1] = glm::vec4(
+    t * axis.x * axis.y - s * axis.z,
+    t * axis.y * axis.y + c,
+    t * axis.y * axis.z + s * axis.x, 0.0f) * scale.y;
+  m[2] = glm::vec4(
+    t * axis.x * axis.z + s * axis.y,
+    t * axis.y * axis.z - s * axis.x,
+    t * axis.z * axis.z + c, 0.0f) * scale.z;
+  m[3] = glm::vec4(m_positions[index], 1.0f);
+
+  // 회전은 sphere에 영향이 없으므로 중심은 위치, 반지름은 가장 큰 scale 기준
+  m_boundsX[index] = m_positions[index].x;
+  m_boundsY[index] = m_positions[index].y;
+  m_boundsZ[index] = m_positions[index].z;
+  m_boundsRadius[index] = m_localRadii[index] *
+    std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z)));
+}
+
+/*
+normal matrix = transpose(inverse(mat3(M)))
+  M = T * R * S 이고 R은 직교 행렬이므로
+  transpose(inverse(R * S)) = R * inverse(S)
+  -> i번째 열 = R의 i번째 열 / s_i = M의 i번째 열 / s_i²
+  일반적인 역행렬 계산 없이 열마다 곱셈 한 번으로 끝난다
+  (shader에서 정점마다 하던 inverse()를 object마다 한 번으로 줄임)
+*/
+void Scene::ComputeNormalMatrices() {
+  for (auto index : m_updateIndices) {
+    const auto& m = m_transforms[index];
+    const auto& scale = m_scales[index];
+    float invX = scale.x != 0.0f ? 1.0f / (scale.x * scale.x) : 0.0f;
+    float invY = scale.y != 0.0f ? 1.0f / (scale.y * scale.y) : 0.0f;
+    float invZ = scale.z != 0.0f ? 1.0f / (scale.z * scale.z) : 0.0f;
+    auto& normal = m_normalMatrices[index];
+#if defined(SCENE_SSE)
+    _mm_storeu_ps(glm::value_ptr(normal.columns[0]),
+      _mm_mul_ps(_mm_loadu_ps(glm::value_ptr(m[0])), _mm_set1_ps(invX)));
+    _mm_storeu_ps(glm::value_ptr(normal.columns[1]),
+      _mm_mul_ps(_mm_loadu_ps(glm::value_ptr(m[1])), _mm_set1_ps(invY)));
+    _mm_storeu_ps(glm::value_ptr(normal.columns[2]),
+      _mm_mul_ps(_mm_loadu_ps(glm::value_ptr(m[2])), _mm_set1_ps(invZ)));
+#else
+    normal.columns[0] = m[0] * invX;
+    normal.columns[1] = m[1] * invY;
+    normal.columns[2] = m[2] * invZ;
+#endif
+  }
+}
\ No newline at end of file
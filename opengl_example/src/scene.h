@@ -0,0 +1,91 @@
+#ifndef __SCENE_H__
+#define __SCENE_H__
+
+#include "common.h"
+#include <vector>
+
+/*
+** Scene: 화면에 그릴 object들의 transform 저장소
+  - structure of arrays: 위치, 회전, 크기, world matrix를 각각의 배열에 연속으로 저장
+  - object id는 추가/삭제해도 바뀌지 않는 handle
+    (삭제 시 마지막 object를 빈 자리로 옮겨서 배열을 빈틈없이 유지)
+  - 바뀐 object와 회전 애니메이션 중인 object의 world matrix만 다시 계산
+  - 배열은 미리 확보해두므로 object 수가 그대로면 매 프레임 heap 할당이 없다
+*/
+// normal matrix (3x3): SIMD 연산과 GPU 업로드를 위해 열마다 vec4로 padding
+struct NormalMatrix {
+  glm::vec4 columns[3];
+};
+
+CLASS_PTR(Scene)
+class Scene {
+public:
+  static SceneUPtr Create(size_t capacity);
+
+  // rotationAngle, rotationSpeed 단위: degree, degree/sec
+  // boundingRadius: 원점 중심의 mesh를 감싸는 sphere 반지름 (scale 적용 전)
+  uint32_t AddObject(const glm::vec3& position,
+    const glm::vec3& rotationAxis, float rotationAngle,
+    float rotationSpeed = 0.0f,
+    const glm::vec3& scale = glm::vec3(1.0f),
+    float boundingRadius = 1.0f);
+  void RemoveObject(uint32_t id);
+
+  void SetPosition(uint32_t id, const glm::vec3& position);
+  void SetRotation(uint32_t id, const glm::vec3& axis, float angle);
+  void SetScale(uint32_t id, const glm::vec3& scale);
+
+  // time(sec) 기준으로 필요한 world matrix 갱신
+  void Update(float time);
+
+  size_t GetObjectCount() const { return m_positions.size(); }
+  const glm::mat4* GetTransforms() const { return m_transforms.data(); }
+  // transpose(inverse(mat3(transform))), transform과 같이 갱신됨
+  const NormalMatrix* GetNormalMatrices() const { return m_normalMatrices.data(); }
+  // x, y, z scale이 다른 object가 있으면 shader에서 mat3(transform)을 normal 변환에 쓸 수 없다
+  bool HasNonUniformScale() const { return m_nonUniformScaleCount > 0; }
+  // world space bounding sphere (frustum culling 용 SoA)
+  const float* GetBoundsX() const { return m_boundsX.data(); }
+  const float* GetBoundsY() const { return m_boundsY.data(); }
+  const float* GetBoundsZ() const { return m_boundsZ.data(); }
+  const float* GetBoundsRadius() const { return m_boundsRadius.data(); }
+  // object 별로 지난 프레임에 고른 mesh LOD (SelectLod()의 hysteresis 기준, 새 object는 0)
+  uint8_t* GetLodLevels() { return m_lodLevels.data(); }
+  // 마지막 Update()에서 다시 계산한 matrix 개수
+  size_t GetUpdatedCount() const { return m_updatedCount; }
+
+private:
+  Scene() {}
+  void Init(size_t capacity);
+  void ComputeTransform(size_t index);
+  void ComputeNormalMatrices();
+
+  std::vector<glm::vec3> m_positions;
+  std::vector<glm::vec3> m_rotationAxes;
+  std::vector<float> m_rotationAngles;
+  std::vector<float> m_rotationSpeeds;
+  std::vector<glm::vec3> m_scales;
+  std::vector<float> m_localRadii;
+  std::vector<glm::mat4> m_transforms;
+  std::vector<NormalMatrix> m_normalMatrices;
+  std::vector<uint8_t> m_dirty;
+  // 이번 Update()에서 갱신할 object index
+  std::vector<uint32_t> m_updateIndices;
+  size_t m_nonUniformScaleCount { 0 };
+
+  std::vector<float> m_boundsX;
+  std::vector<float> m_boundsY;
+  std::vector<float> m_boundsZ;
+  std::vector<float> m_boundsRadius;
+  std::vector<uint8_t> m_lodLevels;
+
+  // id <-> 배열 index 변환 table
+  std::vector<uint32_t> m_indexToId;
+  std::vector<uint32_t> m_idToIndex;
+  std::vector<uint32_t> m_freeIds;
+
+  float m_time { 0.0f };
+  size_t m_updatedCount { 0 };
+};
+
+#endif // __SCENE_H__
@@ -1,54 +1,256 @@
 #include "texture.h"
+#include "gl_state.h"
+#include "mipmap_generator.h"
+#include <algorithm>
 
 TextureUPtr Texture::CreateFromImage(const Image* image) {
   auto texture = TextureUPtr(new Texture());
   texture->CreateTexture();
-  texture->SetTextureFromImage(image);
+  // mip level이 없는 image는 GL의 glGenerateMipmap() 대신 CPU에서 만들어 같이 올림
+  // (기본 MipmapOptions: sRGB 색 texture, 데이터 texture는 level을 붙여서 넘길 것)
+  std::vector<ImageUPtr> mipLevels;
+  if (image->GetLevelCount() == 1)
+    mipLevels = MipmapGenerator::Generate(image);
+  texture->Upload(image, nullptr, 0, &mipLevels);
   
   return std::move(texture);
 }
 
+TextureUPtr Texture::CreateFromLevels(const TextureFormat& format,
+  const TextureLevelData* levels, int levelCount) {
+  auto texture = TextureUPtr(new Texture());
+  texture->CreateTexture();
+  if (!texture->UploadLevels(format, levels, levelCount))
+    return nullptr;
+  return std::move(texture);
+}
+
+TextureUPtr Texture::CreateFromCompressed(uint32_t format,
+  const TextureLevelData* levels, int levelCount) {
+  // blockSize는 level 크기 검사에만 쓰임 (upload는 level마다 받은 size를 그대로 사용)
+  bool bc1 = format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ||
+    format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+  return CreateFromLevels({ format, 0, 0, bc1 ? 8u : 16u }, levels, levelCount);
+}
+
+TextureUPtr Texture::CreateFromFile(const TextureFile* file) {
+  auto texture = CreateFromLevels(file->GetFormat(), file->GetLevels(), file->GetLevelCount());
+  if (texture)
+    texture->m_topDown = file->IsTopDown();
+  return std::move(texture);
+}
+
 Texture::~Texture() {
+  DeleteTexture();
+}
+
+void Texture::DeleteTexture() {
   if (m_texture) {
     glDeleteTextures(1, &m_texture);
+    GLState::ForgetTexture(m_texture);
+    m_texture = 0;
   }
 }
 
 void Texture::Bind() const {
-  glBindTexture(GL_TEXTURE_2D, m_texture);
+  GLState::BindTexture(GL_TEXTURE_2D, m_texture);
 }
 
-void Texture::SetFilter(uint32_t minFilter, uint32_t magFilter) const {
+void Texture::Bind(uint32_t unit) const {
+  GLState::BindTexture(unit, GL_TEXTURE_2D, m_texture);
+}
+
+void Texture::SetFilter(uint32_t minFilter, uint32_t magFilter) {
+  m_minFilter = minFilter;
+  m_magFilter = magFilter;
+  if (GLState::HasDirectStateAccess()) {
+    glTextureParameteri(m_texture, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTextureParameteri(m_texture, GL_TEXTURE_MAG_FILTER, magFilter);
+    return;
+  }
+  Bind();
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
 }
 
-void Texture::SetWrap(uint32_t sWrap, uint32_t tWrap) const {
+void Texture::SetWrap(uint32_t sWrap, uint32_t tWrap) {
+  m_sWrap = sWrap;
+  m_tWrap = tWrap;
+  if (GLState::HasDirectStateAccess()) {
+    glTextureParameteri(m_texture, GL_TEXTURE_WRAP_S, sWrap);
+    glTextureParameteri(m_texture, GL_TEXTURE_WRAP_T, tWrap);
+    return;
+  }
+  Bind();
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, sWrap);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, tWrap);
 }
-    
+
+/*
+glCreateTextures(target, n, textures): (DSA)
+  이름과 함께 target 종류의 texture 객체를 바로 만듦
+  -> 바인딩하지 않고 glTextureParameteri(texture, ...) 등으로 설정 가능
+*/
 void Texture::CreateTexture() {
-  glGenTextures(1, &m_texture);
-  // bind and set default filter and wrap option
-  Bind();
-  SetFilter(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
-  SetWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+  if (GLState::HasDirectStateAccess())
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_texture);
+  else
+    glGenTextures(1, &m_texture);
+  // set filter and wrap option (처음에는 기본값, 다시 만들 때는 이전 설정)
+  SetFilter(m_minFilter, m_magFilter);
+  SetWrap(m_sWrap, m_tWrap);
 }
 
 void Texture::SetTextureFromImage(const Image* image) {
-  GLenum format = GL_RGBA;
+  Upload(image, nullptr, 0);
+}
+
+void Texture::SetImage(const Image* image) {
+  DeleteTexture();
+  CreateTexture();
+  SetTextureFromImage(image);
+  m_topDown = false;
+}
+
+/*
+GL_PIXEL_UNPACK_BUFFER (PBO, pixel buffer object):
+  바인딩되어 있으면 glTexImage2D() / glTexSubImage2D()의 pixel pointer를 buffer 안의 offset으로 읽음
+  -> CPU 메모리에서 복사하는 대신 driver가 GPU 쪽에서 비동기로 가져갈 수 있다
+  다른 upload가 잘못 읽지 않도록 다 쓴 뒤에는 바로 0으로 되돌림
+*/
+void Texture::SetImageFromPixelBuffer(const Image* image, const Buffer* pixelBuffer,
+  size_t offset) {
+  DeleteTexture();
+  CreateTexture();
+  pixelBuffer->Bind();
+  Upload(image, pixelBuffer, offset);
+  GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  m_topDown = false;
+}
+
+static bool IsFormatSupported(const TextureFormat& format) {
+  if (!format.IsCompressed())
+    return true;
+  switch (format.internalFormat) {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+      return GLAD_GL_EXT_texture_compression_s3tc;
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+      return GLAD_GL_VERSION_4_2 || GLAD_GL_ARB_texture_compression_bptc;
+    default:
+      return false;
+  }
+}
+
+bool Texture::SetLevels(const TextureFormat& format, const TextureLevelData* levels,
+  int levelCount) {
+  if (levelCount <= 0 || !IsFormatSupported(format)) {
+    SPDLOG_ERROR("unsupported texture format: {:#x}", format.internalFormat);
+    return false;
+  }
+  DeleteTexture();
+  CreateTexture();
+  m_topDown = false;
+  return UploadLevels(format, levels, levelCount);
+}
+
+bool Texture::SetFromFile(const TextureFile* file) {
+  if (!SetLevels(file->GetFormat(), file->GetLevels(), file->GetLevelCount()))
+    return false;
+  m_topDown = file->IsTopDown();
+  return true;
+}
+
+/*
+Image의 level들을 RGBA8 storage에 올림 (channel 수는 format으로만 구분)
+pixelBuffer가 있으면 pointer 대신 PBO 안의 offset (level이 순서대로 이어져 있음)
+mipLevels가 비어 있지 않으면 image의 level 1 이후 대신 사용
+*/
+void Texture::Upload(const Image* image, const Buffer* pixelBuffer, size_t offset,
+  const std::vector<ImageUPtr>* mipLevels) {
+  TextureFormat format { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE,
+    (uint32_t)image->GetChannelCount() };
   switch (image->GetChannelCount()) {
     default: break;
-    case 1: format = GL_RED; break;
-    case 2: format = GL_RG; break;
-    case 3: format = GL_RGB; break;
+    case 1: format.format = GL_RED; break;
+    case 2: format.format = GL_RG; break;
+    case 3: format.format = GL_RGB; break;
   }
-  
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-    image->GetWidth(), image->GetHeight(), 0,
-    format, GL_UNSIGNED_BYTE,
-    image->GetData());
-  
-  glGenerateMipmap(GL_TEXTURE_2D);
-}
\ No newline at end of file
+
+  bool extraLevels = mipLevels && !mipLevels->empty();
+  int levelCount = extraLevels ? 1 + (int)mipLevels->size() : image->GetLevelCount();
+  std::vector<TextureLevelData> levels(levelCount);
+  for (int i = 0; i < levelCount; i++) {
+    auto level = extraLevels && i > 0 ? (*mipLevels)[i - 1].get() : image->GetLevel(i);
+    levels[i].width = level->GetWidth();
+    levels[i].height = level->GetHeight();
+    levels[i].data = pixelBuffer ? (const void*)offset : level->GetData();
+    levels[i].size = level->GetDataSize();
+    offset += level->GetDataSize();
+  }
+  UploadLevels(format, levels.data(), (int)levels.size());
+}
+
+/*
+glTextureStorage2D(texture, levels, internalFormat, width, height): (DSA)
+  mip level 전체의 크기와 형식을 한 번에 고정 (immutable storage)
+  -> 이후 크기 / 형식은 바꿀 수 없고 glTextureSubImage2D()로 내용만 채움
+  -> driver가 level마다 완전성(completeness)을 다시 검사하지 않아도 됨
+glCompressedTexImage2D(target, level, internalFormat, width, height, border, imageSize, data):
+  block 압축된 데이터를 풀지 않고 그대로 GPU 메모리에 복사 (sampling할 때 GPU가 block 단위로 풀음)
+  -> RGBA8 대비 BC1은 1/8, BC3 / BC7은 1/4 크기라 VRAM과 upload 대역폭이 같이 줄어듦
+mip level은 모두 호출한 쪽이 준비 (MipmapGenerator, 파일에 든 level): GL thread에서 생성하지 않음
+있는 level까지만 쓰도록 GL_TEXTURE_MAX_LEVEL로 알려줌 (DSA는 storage level 수로 고정)
+GL_UNPACK_ALIGNMENT: 한 줄의 byte 수가 4의 배수가 아니면(RGB 홀수 폭 등) 1로 낮춰서 읽음
+*/
+bool Texture::UploadLevels(const TextureFormat& format, const TextureLevelData* levels,
+  int levelCount) {
+  if (levelCount <= 0 || !IsFormatSupported(format)) {
+    SPDLOG_ERROR("unsupported texture format: {:#x}", format.internalFormat);
+    return false;
+  }
+  m_width = levels[0].width;
+  m_height = levels[0].height;
+  bool compressed = format.IsCompressed();
+  bool dsa = GLState::HasDirectStateAccess();
+  if (dsa) {
+    glTextureStorage2D(m_texture, levelCount, format.internalFormat, m_width, m_height);
+  }
+  else {
+    Bind();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+  }
+  for (int i = 0; i < levelCount; i++) {
+    const auto& level = levels[i];
+    if (compressed) {
+      if (dsa) {
+        glCompressedTextureSubImage2D(m_texture, i, 0, 0, level.width, level.height,
+          format.internalFormat, (GLsizei)level.size, level.data);
+      }
+      else {
+        glCompressedTexImage2D(GL_TEXTURE_2D, i, format.internalFormat,
+          level.width, level.height, 0, (GLsizei)level.size, level.data);
+      }
+      continue;
+    }
+
+    bool packedRows = (level.width * format.blockSize) % 4 != 0;
+    if (packedRows)
+      glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (dsa) {
+      glTextureSubImage2D(m_texture, i, 0, 0, level.width, level.height,
+        format.format, format.type, level.data);
+    }
+    else {
+      glTexImage2D(GL_TEXTURE_2D, i, format.internalFormat,
+        level.width, level.height, 0,
+        format.format, format.type,
+        level.data);
+    }
+    if (packedRows)
+      glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  }
+  return true;
+}
@@ -2,6 +2,8 @@
 #define __TEXTURE_H__
 
 #include "image.h"
+#include "buffer.h"
+#include "texture_file.h"
 
 CLASS_PTR(Texture)
 class Texture {
@@ -9,19 +11,54 @@ public:
   // ImagePtr/UPtr이 아닌 Image*를 인자로 쓰는 이유:
   // Texture의 함수가 수행하는 명령에서 딱히 Image의 소유권이 상관x -> 빠른 작업을 위해 Image*
   static TextureUPtr CreateFromImage(const Image* image);
+  // 이미 GPU 형식인 level들을 그대로 올림 (압축 형식을 지원하지 않으면 nullptr)
+  static TextureUPtr CreateFromLevels(const TextureFormat& format,
+    const TextureLevelData* levels, int levelCount);
+  // block 압축된 level들을 그대로 올림 (format: GL_COMPRESSED_*, 지원하지 않으면 nullptr)
+  static TextureUPtr CreateFromCompressed(uint32_t format,
+    const TextureLevelData* levels, int levelCount);
+  // .dds / .ktx2: Image::Load() + CreateFromImage() 대신 mapping된 level을 바로 올림
+  static TextureUPtr CreateFromFile(const TextureFile* file);
   ~Texture();
   
   const uint32_t Get() const { return m_texture; }
   void Bind() const;
-  void SetFilter(uint32_t minFilter, uint32_t magFilter) const;
-  void SetWrap(uint32_t sWrap, uint32_t tWrap) const;
-    
+  // 텍스처 슬롯(GL_TEXTURE0 + unit)에 바인딩
+  void Bind(uint32_t unit) const;
+  void SetFilter(uint32_t minFilter, uint32_t magFilter);
+  void SetWrap(uint32_t sWrap, uint32_t tWrap);
+  int GetWidth() const { return m_width; }
+  int GetHeight() const { return m_height; }
+  // 위 줄부터 저장된 texture (.dds, KTX2 "rd"): shader에서 v를 뒤집어 sampling해야 함
+  bool IsTopDown() const { return m_topDown; }
+
+  // 저장 공간을 image 크기로 다시 만들고 내용을 올림
+  // (크기가 고정된 storage일 수 있어 GL texture 이름이 바뀜, filter / wrap 설정은 유지)
+  // pixelBuffer(GL_PIXEL_UNPACK_BUFFER)를 주면 image의 level들이 offset부터 이어져 있다고 보고 읽음
+  void SetImage(const Image* image);
+  void SetImageFromPixelBuffer(const Image* image, const Buffer* pixelBuffer, size_t offset);
+  // SetImage()의 GPU 형식 level 버전 (실패하면 원래 texture를 그대로 둠)
+  bool SetLevels(const TextureFormat& format, const TextureLevelData* levels, int levelCount);
+  // SetLevels() + 파일의 줄 순서
+  bool SetFromFile(const TextureFile* file);
+
 private:
   Texture() {}
   void CreateTexture();
+  void DeleteTexture();
   void SetTextureFromImage(const Image* image);
+  void Upload(const Image* image, const Buffer* pixelBuffer, size_t offset,
+    const std::vector<ImageUPtr>* mipLevels = nullptr);
+  bool UploadLevels(const TextureFormat& format, const TextureLevelData* levels, int levelCount);
 
   uint32_t m_texture { 0 };
+  int m_width { 0 };
+  int m_height { 0 };
+  uint32_t m_minFilter { GL_LINEAR_MIPMAP_LINEAR };
+  uint32_t m_magFilter { GL_LINEAR };
+  uint32_t m_sWrap { GL_CLAMP_TO_EDGE };
+  uint32_t m_tWrap { GL_CLAMP_TO_EDGE };
+  bool m_topDown { false };
 };
 
 #endif // __TEXTURE_H__
\ No newline at end of file
@@ -0,0 +1,383 @@
+#include "texture_compressor.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace {
+
+constexpr int BLOCK_TEXEL_COUNT = 16;
+
+// 압축 전 texel을 RGBA로 (Texture가 GL_RED / GL_RG / GL_RGB로 올릴 때와 같은 값)
+void FetchTexel(const Image* image, int x, int y, uint8_t* rgba) {
+  int channelCount = image->GetChannelCount();
+  const uint8_t* texel = image->GetData() +
+    ((size_t)y * image->GetWidth() + x) * channelCount;
+  rgba[0] = texel[0];
+  rgba[1] = channelCount >= 2 ? texel[1] : 0;
+  rgba[2] = channelCount >= 3 ? texel[2] : 0;
+  rgba[3] = channelCount >= 4 ? texel[3] : 255;
+}
+
+// image 밖(4의 배수가 아닌 크기의 가장자리 block)은 가장자리 texel을 반복
+void FetchBlock(const Image* image, int blockX, int blockY, uint8_t* rgba) {
+  for (int y = 0; y < 4; y++) {
+    int sy = std::min(blockY * 4 + y, image->GetHeight() - 1);
+    for (int x = 0; x < 4; x++) {
+      int sx = std::min(blockX * 4 + x, image->GetWidth() - 1);
+      FetchTexel(image, sx, sy, rgba + (y * 4 + x) * 4);
+    }
+  }
+}
+
+uint16_t Pack565(const glm::vec3& color) {
+  auto r = (uint16_t)std::lround(std::clamp(color.x, 0.0f, 255.0f) * 31.0f / 255.0f);
+  auto g = (uint16_t)std::lround(std::clamp(color.y, 0.0f, 255.0f) * 63.0f / 255.0f);
+  auto b = (uint16_t)std::lround(std::clamp(color.z, 0.0f, 255.0f) * 31.0f / 255.0f);
+  return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+glm::vec3 Unpack565(uint16_t color) {
+  int r = (color >> 11) & 31;
+  int g = (color >> 5) & 63;
+  int b = color & 31;
+  return glm::vec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+// BC1 4색 모드 palette: c0, c1, (2 c0 + c1) / 3, (c0 + 2 c1) / 3
+void BuildPalette(uint16_t color0, uint16_t color1, glm::vec3* palette) {
+  palette[0] = Unpack565(color0);
+  palette[1] = Unpack565(color1);
+  palette[2] = (2.0f * palette[0] + palette[1]) / 3.0f;
+  palette[3] = (palette[0] + 2.0f * palette[1]) / 3.0f;
+}
+
+float AssignIndices(const glm::vec3* colors, const glm::vec3* palette, uint8_t* indices) {
+  float totalError = 0.0f;
+  for (int i = 0; i < BLOCK_TEXEL_COUNT; i++) {
+    float bestError = std::numeric_limits<float>::max();
+    for (uint8_t p = 0; p < 4; p++) {
+      glm::vec3 d = colors[i] - palette[p];
+      float error = glm::dot(d, d);
+      if (error < bestError) {
+        bestError = error;
+        indices[i] = p;
+      }
+    }
+    totalError += bestError;
+  }
+  return totalError;
+}
+
+/*
+index를 고정했을 때 오차 제곱합이 최소인 끝점 (최소 제곱)
+  texel i = w_i * e0 + (1 - w_i) * e1, w = 1, 0, 2/3, 1/3 (index 0 ~ 3)
+*/
+bool FitEndpoints(const glm::vec3* colors, const uint8_t* indices,
+  glm::vec3& endpoint0, glm::vec3& endpoint1) {
+  static const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+  float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+  glm::vec3 ax(0.0f), bx(0.0f);
+  for (int i = 0; i < BLOCK_TEXEL_COUNT; i++) {
+    float a = weights[indices[i]];
+    float b = 1.0f - a;
+    aa += a * a;
+    ab += a * b;
+    bb += b * b;
+    ax += a * colors[i];
+    bx += b * colors[i];
+  }
+  float det = aa * bb - ab * ab;
+  if (std::abs(det) < 1e-6f)
+    return false;
+  endpoint0 = (ax * bb - bx * ab) / det;
+  endpoint1 = (bx * aa - ax * ab) / det;
+  return true;
+}
+
+void WriteColorBlock(uint16_t color0, uint16_t color1, const uint8_t* indices, uint8_t* out) {
+  // color0 > color1이어야 4색 모드 (같으면 index 0만 사용)
+  uint8_t remap[4] = { 0, 1, 2, 3 };
+  if (color0 < color1) {
+    std::swap(color0, color1);
+    remap[0] = 1; remap[1] = 0; remap[2] = 3; remap[3] = 2;
+  }
+  uint32_t bits = 0;
+  for (int i = 0; i < BLOCK_TEXEL_COUNT; i++) {
+    uint32_t index = color0 == color1 ? 0 : remap[indices[i]];
+    bits |= index << (2 * i);
+  }
+  out[0] = (uint8_t)(color0 & 0xFF);
+  out[1] = (uint8_t)(color0 >> 8);
+  out[2] = (uint8_t)(color1 & 0xFF);
+  out[3] = (uint8_t)(color1 >> 8);
+  for (int i = 0; i < 4; i++)
+    out[4 + i] = (uint8_t)(bits >> (8 * i));
+}
+
+void EncodeColorBlock(const uint8_t* rgba, uint8_t* out) {
+  glm::vec3 colors[BLOCK_TEXEL_COUNT];
+  glm::vec3 mean(0.0f);
+  for (int i = 0; i < BLOCK_TEXEL_COUNT; i++) {
+    colors[i] = glm::vec3(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]);
+    mean += colors[i];
+  }
+  mean /= (float)BLOCK_TEXEL_COUNT;
+
+  // 공분산 행렬의 주성분 (power iteration)
+  // 대칭 행렬이므로 위 삼각형 6개만: xx, xy, xz, yy, yz, zz
+  float covariance[6] {};
+  for (const auto& color : colors) {
+    glm::vec3 d = color - mean;
+    covariance[0] += d.x * d.x;
+    covariance[1] += d.x * d.y;
+    covariance[2] += d.x * d.z;
+    covariance[3] += d.y * d.y;
+    covariance[4] += d.y * d.z;
+    covariance[5] += d.z * d.z;
+  }
+  glm::vec3 axis(1.0f, 1.0f, 1.0f);
+  for (int i = 0; i < 8; i++) {
+    axis = glm::vec3(
+      covariance[0] * axis.x + covariance[1] * axis.y + covariance[2] * axis.z,
+      covariance[1] * axis.x + covariance[3] * axis.y + covariance[4] * axis.z,
+      covariance[2] * axis.x + covariance[4] * axis.y + covariance[5] * axis.z);
+    float length = glm::length(axis);
+    if (length < 1e-6f)
+      break;
+    axis /= length;
+  }
+  float minProjection = 0.0f;
+  float maxProjection = 0.0f;
+  for (const auto& color : colors) {
+    float projection = glm::dot(color - mean, axis);
+    minProjection = std::min(minProjection, projection);
+    maxProjection = std::max(maxProjection, projection);
+  }
+
+  uint16_t color0 = Pack565(mean + axis * maxProjection);
+  uint16_t color1 = Pack565(mean + axis * minProjection);
+  glm::vec3 palette[4];
+  uint8_t indices[BLOCK_TEXEL_COUNT];
+  BuildPalette(color0, color1, palette);
+  float error = AssignIndices(colors, palette, indices);
+
+  // 끝점 다시 맞추기: 오차가 줄어들 때만 채택
+  for (int iteration = 0; iteration < 2 && error > 0.0f; iteration++) {
+    glm::vec3 endpoint0, endpoint1;
+    if (!FitEndpoints(colors, indices, endpoint0, endpoint1))
+      break;
+    uint16_t newColor0 = Pack565(endpoint0);
+    uint16_t newColor1 = Pack565(endpoint1);
+    glm::vec3 newPalette[4];
+    uint8_t newIndices[BLOCK_TEXEL_COUNT];
+    BuildPalette(newColor0, newColor1, newPalette);
+    float newError = AssignIndices(colors, newPalette, newIndices);
+    if (newError >= error)
+      break;
+    color0 = newColor0;
+    color1 = newColor1;
+    error = newError;
+    std::copy(newIndices, newIndices + BLOCK_TEXEL_COUNT, indices);
+  }
+  WriteColorBlock(color0, color1, indices, out);
+}
+
+// BC3 alpha: a0 > a1이면 8단계 (a0, a1, 그 사이 6개)
+void EncodeAlphaBlock(const uint8_t* rgba, uint8_t* out) {
+  uint8_t maxAlpha = 0;
+  uint8_t minAlpha = 255;
+  for (int i = 0; i < BLOCK_TEXEL_COUNT; i++) {
+    maxAlpha = std::max(maxAlpha, rgba[i * 4 + 3]);
+    minAlpha = std::min(minAlpha, rgba[i * 4 + 3]);
+  }
+  out[0] = maxAlpha;
+  out[1] = minAlpha;
+  uint64_t bits = 0;
+  if (maxAlpha != minAlpha) {
+    int palette[8] = { maxAlpha, minAlpha };
+    for (int p = 1; p < 7; p++)
+      palette[p + 1] = ((7 - p) * maxAlpha + p * minAlpha + 3) / 7;
+    for (int i = 0; i < BLOCK_TEXEL_COUNT; i++) {
+      int alpha = rgba[i * 4 + 3];
+      uint64_t bestIndex = 0;
+      int bestError = 256;
+      for (int p = 0; p < 8; p++) {
+        int error = std::abs(alpha - palette[p]);
+        if (error < bestError) {
+          bestError = error;
+          bestIndex = (uint64_t)p;
+        }
+      }
+      bits |= bestIndex << (3 * i);
+    }
+  }
+  for (int i = 0; i < 6; i++)
+    out[2 + i] = (uint8_t)(bits >> (8 * i));
+}
+
+void DecodeColorBlock(const uint8_t* block, uint8_t* rgba) {
+  uint16_t color0 = (uint16_t)(block[0] | (block[1] << 8));
+  uint16_t color1 = (uint16_t)(block[2] | (block[3] << 8));
+  glm::vec3 palette[4];
+  BuildPalette(color0, color1, palette);
+  if (color0 <= color1) {
+    palette[2] = (palette[0] + palette[1]) * 0.5f;
+    palette[3] = glm::vec3(0.0f);
+  }
+  uint32_t bits = block[4] | (block[5] << 8) | (block[6] << 16) | ((uint32_t)block[7] << 24);
+  for (int i = 0; i < BLOCK_TEXEL_COUNT; i++) {
+    const auto& color = palette[(bits >> (2 * i)) & 3];
+    rgba[i * 4] = (uint8_t)std::lround(color.x);
+    rgba[i * 4 + 1] = (uint8_t)std::lround(color.y);
+    rgba[i * 4 + 2] = (uint8_t)std::lround(color.z);
+    rgba[i * 4 + 3] = 255;
+  }
+}
+
+void DecodeAlphaBlock(const uint8_t* block, uint8_t* rgba) {
+  int palette[8] = { block[0], block[1] };
+  if (block[0] > block[1]) {
+    for (int p = 1; p < 7; p++)
+      palette[p + 1] = ((7 - p) * block[0] + p * block[1] + 3) / 7;
+  }
+  else {
+    for (int p = 1; p < 5; p++)
+      palette[p + 1] = ((5 - p) * block[0] + p * block[1] + 2) / 5;
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+  uint64_t bits = 0;
+  for (int i = 0; i < 6; i++)
+    bits |= (uint64_t)block[2 + i] << (8 * i);
+  for (int i = 0; i < BLOCK_TEXEL_COUNT; i++)
+    rgba[i * 4 + 3] = (uint8_t)palette[(bits >> (3 * i)) & 7];
+}
+
+// block 줄 count개를 thread가 하나씩 가져가서 처리
+template <typename Func>
+void ParallelRows(int count, int threadCount, const Func& func) {
+  if (threadCount <= 0)
+    threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+  int workerCount = std::min(count, threadCount);
+  std::atomic<int> next { 0 };
+  auto worker = [&]() {
+    for (int i = next++; i < count; i = next++)
+      func(i);
+  };
+  std::vector<std::thread> threads;
+  for (int i = 1; i < workerCount; i++)
+    threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads)
+    thread.join();
+}
+
+} // namespace
+
+uint32_t TextureCompressor::GetBlockSize(BlockFormat format) {
+  return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+uint32_t TextureCompressor::GetGLFormat(BlockFormat format) {
+  return format == BlockFormat::BC1 ?
+    GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+}
+
+size_t TextureCompressor::GetCompressedSize(BlockFormat format, int width, int height) {
+  return (size_t)((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+}
+
+CompressedImage TextureCompressor::Compress(const Image* image, BlockFormat format,
+  int threadCount) {
+  CompressedImage result;
+  result.format = format;
+  for (int i = 0; i < image->GetLevelCount(); i++)
+    result.levels.push_back(CompressLevel(image->GetLevel(i), format, threadCount));
+  return result;
+}
+
+CompressedLevel TextureCompressor::CompressLevel(const Image* image, BlockFormat format,
+  int threadCount) {
+  CompressedLevel level;
+  level.width = image->GetWidth();
+  level.height = image->GetHeight();
+  level.data.resize(GetCompressedSize(format, level.width, level.height));
+  int blockCountX = (level.width + 3) / 4;
+  int blockCountY = (level.height + 3) / 4;
+  uint32_t blockSize = GetBlockSize(format);
+  ParallelRows(blockCountY, threadCount, [&](int blockY) {
+    uint8_t rgba[BLOCK_TEXEL_COUNT * 4];
+    uint8_t* out = level.data.data() + (size_t)blockY * blockCountX * blockSize;
+    for (int blockX = 0; blockX < blockCountX; blockX++, out += blockSize) {
+      FetchBlock(image, blockX, blockY, rgba);
+      if (format == BlockFormat::BC3) {
+        EncodeAlphaBlock(rgba, out);
+        EncodeColorBlock(rgba, out + 8);
+      }
+      else {
+        EncodeColorBlock(rgba, out);
+      }
+    }
+  });
+  return level;
+}
+
+std::vector<uint8_t> TextureCompressor::Decompress(const CompressedLevel& level,
+  BlockFormat format) {
+  std::vector<uint8_t> pixels((size_t)level.width * level.height * 4);
+  int blockCountX = (level.width + 3) / 4;
+  int blockCountY = (level.height + 3) / 4;
+  uint32_t blockSize = GetBlockSize(format);
+  const uint8_t* block = level.data.data();
+  uint8_t rgba[BLOCK_TEXEL_COUNT * 4];
+  for (int blockY = 0; blockY < blockCountY; blockY++) {
+    for (int blockX = 0; blockX < blockCountX; blockX++, block += blockSize) {
+      if (format == BlockFormat::BC3) {
+        DecodeColorBlock(block + 8, rgba);
+        DecodeAlphaBlock(block, rgba);
+      }
+      else {
+        DecodeColorBlock(block, rgba);
+      }
+      for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+          int px = blockX * 4 + x;
+          int py = blockY * 4 + y;
+          if (px < level.width && py < level.height)
+            std::copy(rgba + (y * 4 + x) * 4, rgba + (y * 4 + x) * 4 + 4,
+              pixels.data() + ((size_t)py * level.width + px) * 4);
+        }
+      }
+    }
+  }
+  return pixels;
+}
+
+/*
+PSNR = 10 * log10(255^2 / MSE)
+  MSE: 원본과 압축을 푼 값의 channel 별 차이 제곱 평균
+  보통 BC1 색은 35 ~ 45dB 정도, 높을수록 원본에 가까움
+*/
+double TextureCompressor::ComputePsnr(const Image* image, const CompressedLevel& level,
+  BlockFormat format) {
+  auto decoded = Decompress(level, format);
+  int channelCount = format == BlockFormat::BC3 ? 4 : 3;
+  double squaredError = 0.0;
+  uint8_t original[4];
+  for (int y = 0; y < level.height; y++) {
+    for (int x = 0; x < level.width; x++) {
+      FetchTexel(image, x, y, original);
+      const uint8_t* texel = decoded.data() + ((size_t)y * level.width + x) * 4;
+      for (int k = 0; k < channelCount; k++) {
+        double d = (double)original[k] - texel[k];
+        squaredError += d * d;
+      }
+    }
+  }
+  double mse = squaredError / ((double)level.width * level.height * channelCount);
+  if (mse <= 0.0)
+    return std::numeric_limits<double>::infinity();
+  return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
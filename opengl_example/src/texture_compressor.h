@@ -0,0 +1,48 @@
+#ifndef __TEXTURE_COMPRESSOR_H__
+#define __TEXTURE_COMPRESSOR_H__
+
+#include "image.h"
+#include <vector>
+
+/*
+** GPU block 압축 (offline cook 단계, texture_converter)
+  4x4 texel block 하나를 고정 크기로 저장 -> GPU가 압축된 채로 읽으므로 VRAM / upload가 같이 줄어듦
+  - BC1 (DXT1): block당 8byte (4bpp, RGBA8의 1/8), 565 색 두 개 + 2bit index 16개, alpha 없음
+  - BC3 (DXT5): block당 16byte (8bpp, 1/4), BC1 색 block + 8bit alpha 두 개 + 3bit index 16개
+  색 끝점은 block 색의 주성분 방향으로 잡은 뒤 index를 고정하고 최소 제곱으로 다시 맞춤
+  block 줄 단위로 여러 thread가 나눠서 압축
+*/
+enum class BlockFormat {
+  BC1,
+  BC3,
+};
+
+// 압축된 mip level 하나 (width, height는 texel 크기, data는 block 배열)
+struct CompressedLevel {
+  int width { 0 };
+  int height { 0 };
+  std::vector<uint8_t> data;
+};
+
+struct CompressedImage {
+  BlockFormat format { BlockFormat::BC1 };
+  std::vector<CompressedLevel> levels;
+};
+
+class TextureCompressor {
+public:
+  static uint32_t GetBlockSize(BlockFormat format);
+  // GL_COMPRESSED_RGB(A)_S3TC_DXT*_EXT
+  static uint32_t GetGLFormat(BlockFormat format);
+  static size_t GetCompressedSize(BlockFormat format, int width, int height);
+
+  // image와 image의 mip level을 모두 압축 (threadCount가 0이면 hardware thread 수)
+  static CompressedImage Compress(const Image* image, BlockFormat format, int threadCount = 0);
+  static CompressedLevel CompressLevel(const Image* image, BlockFormat format, int threadCount = 0);
+  // 압축을 풀어 RGBA8 (PSNR 측정용)
+  static std::vector<uint8_t> Decompress(const CompressedLevel& level, BlockFormat format);
+  // image와 압축 결과의 PSNR(dB): BC1은 RGB, BC3은 RGBA 기준 (같으면 infinity)
+  static double ComputePsnr(const Image* image, const CompressedLevel& level, BlockFormat format);
+};
+
+#endif // __TEXTURE_COMPRESSOR_H__
@@ -0,0 +1,95 @@
+#include "image.h"
+#include "mipmap_generator.h"
+#include "texture_compressor.h"
+#include "dds_file.h"
+#include <chrono>
+
+/*
+** Texture converter (offline 도구)
+  image를 GPU block 압축 형식의 .dds로 변환 (mip level 전체 포함)
+  사용법: texture_converter [options] <input image> <output.dds>
+    - 기본 형식: alpha가 있으면 BC3, 없으면 BC1 (--bc1 / --bc3로 지정)
+    - 기본으로 MipmapGenerator로 mip level을 만들어 같이 압축 (--no-mipmap: level 0만)
+    - --linear: specular / normal map 등 색이 아닌 texture (mipmap을 sRGB 변환 없이 평균)
+    - --kaiser: mipmap을 2x2 평균 대신 Kaiser-windowed sinc로 축소 (더 선명, 느림)
+    - --alpha-cutoff V: alpha test로 그릴 texture (잎사귀, 철망 등)의 기준값 (0 < V < 1)
+      level마다 alpha >= V인 texel 비율을 level 0과 같게 맞춤
+    - --threads N: 압축 thread 수 (기본: hardware thread 수)
+  level마다 원본과 압축을 푼 결과의 PSNR을 출력
+  다른 도구와 같이 위 줄부터 저장 (읽을 때 TextureFile이 GL 순서로 뒤집음)
+*/
+int main(int argc, const char** argv) {
+  std::optional<BlockFormat> format;
+  bool generateMipmap = true;
+  MipmapOptions mipmapOptions;
+  int threadCount = 0;
+  int argIndex = 1;
+  for (; argIndex < argc && argv[argIndex][0] == '-'; argIndex++) {
+    std::string option = argv[argIndex];
+    if (option == "--bc1")
+      format = BlockFormat::BC1;
+    else if (option == "--bc3")
+      format = BlockFormat::BC3;
+    else if (option == "--no-mipmap")
+      generateMipmap = false;
+    else if (option == "--linear")
+      mipmapOptions.srgb = false;
+    else if (option == "--kaiser")
+      mipmapOptions.filter = MipmapOptions::Filter::Kaiser;
+    else if (option == "--alpha-cutoff" && argIndex + 1 < argc)
+      mipmapOptions.alphaCutoff = (float)std::atof(argv[++argIndex]);
+    else if (option == "--threads" && argIndex + 1 < argc)
+      threadCount = std::atoi(argv[++argIndex]);
+    else
+      break;
+  }
+  if (argc - argIndex != 2) {
+    SPDLOG_ERROR("usage: {} [--bc1 | --bc3] [--no-mipmap] [--linear] [--kaiser] "
+      "[--alpha-cutoff V] [--threads N] <input image> <output.dds>", argv[0]);
+    return -1;
+  }
+  if (mipmapOptions.alphaCutoff < 0.0f || mipmapOptions.alphaCutoff >= 1.0f) {
+    SPDLOG_ERROR("alpha cutoff must be in (0, 1): {}", mipmapOptions.alphaCutoff);
+    return -1;
+  }
+  std::string input = argv[argIndex];
+  std::string output = argv[argIndex + 1];
+
+  auto image = Image::Load(input);
+  if (!image)
+    return -1;
+  // Image::Load()는 GL 순서(아래 줄부터)로 돌려주므로 DDS 표준 순서(위 줄부터)로 되돌려서 압축
+  image->FlipVertical();
+  bool hasAlpha = image->GetChannelCount() == 2 || image->GetChannelCount() == 4;
+  if (!format)
+    format = hasAlpha ? BlockFormat::BC3 : BlockFormat::BC1;
+  if (mipmapOptions.alphaCutoff > 0.0f && !hasAlpha)
+    SPDLOG_WARN("alpha cutoff ignored: {} has no alpha channel", input);
+  if (generateMipmap)
+    image->SetMipLevels(MipmapGenerator::Generate(image.get(), mipmapOptions));
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto compressed = TextureCompressor::Compress(image.get(), *format, threadCount);
+  auto end = std::chrono::high_resolution_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+  // 비교 기준: 지금 Texture가 올리는 RGBA8 (channel 수와 상관없이 GL_RGBA 저장)
+  size_t uncompressedSize = 0;
+  size_t compressedSize = 0;
+  for (int i = 0; i < image->GetLevelCount(); i++) {
+    auto level = image->GetLevel(i);
+    const auto& compressedLevel = compressed.levels[i];
+    uncompressedSize += (size_t)level->GetWidth() * level->GetHeight() * 4;
+    compressedSize += compressedLevel.data.size();
+    SPDLOG_INFO("level {}: {}x{}, PSNR {:.2f} dB", i, level->GetWidth(), level->GetHeight(),
+      TextureCompressor::ComputePsnr(level, compressedLevel, *format));
+  }
+  SPDLOG_INFO("compressed {} as {} in {:.1f} ms: {} levels, {} -> {} bytes ({:.1f}x)",
+    input, *format == BlockFormat::BC1 ? "BC1" : "BC3", ms, image->GetLevelCount(),
+    uncompressedSize, compressedSize, (double)uncompressedSize / compressedSize);
+
+  if (!DdsFile::Write(output, compressed))
+    return -1;
+  SPDLOG_INFO("wrote {}", output);
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include "texture_file.h"
+#include "dds_file.h"
+#include "ktx2_file.h"
+#include <algorithm>
+#include <cctype>
+
+bool TextureFile::IsTextureFile(const std::string& filename) {
+  auto dot = filename.find_last_of('.');
+  if (dot == std::string::npos)
+    return false;
+  std::string extension = filename.substr(dot + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+    [](char c) { return (char)std::tolower((unsigned char)c); });
+  return extension == "dds" || extension == "ktx2";
+}
+
+TextureFileUPtr TextureFile::Load(const std::string& filename) {
+  auto textureFile = TextureFileUPtr(new TextureFile());
+  if (!textureFile->Init(filename))
+    return nullptr;
+  return std::move(textureFile);
+}
+
+// container 종류는 확장자가 아니라 파일 앞의 magic으로 구분
+bool TextureFile::Init(const std::string& filename) {
+  m_file = MappedFile::Open(filename);
+  if (!m_file)
+    return false;
+
+  const uint8_t* data = m_file->GetData();
+  size_t size = m_file->GetSize();
+  bool parsed = false;
+  if (DdsFile::IsDdsFile(data, size))
+    parsed = DdsFile::Parse(filename, data, size, m_format, m_levels, m_topDown);
+  else if (Ktx2File::IsKtx2File(data, size))
+    parsed = Ktx2File::Parse(filename, data, size, m_format, m_levels, m_topDown);
+  else
+    SPDLOG_ERROR("unknown texture container: {}", filename);
+  if (!parsed)
+    return false;
+
+  // level i의 크기는 level 0을 i번 반으로 줄인 것 (최소 1), data 크기는 형식에서 정해짐
+  if (m_levels.empty() || m_levels[0].width <= 0 || m_levels[0].height <= 0) {
+    SPDLOG_ERROR("invalid texture size: {}", filename);
+    return false;
+  }
+  int maxLevelCount = 1;
+  while ((std::max(m_levels[0].width, m_levels[0].height) >> maxLevelCount) > 0)
+    maxLevelCount++;
+  if ((int)m_levels.size() > maxLevelCount) {
+    SPDLOG_ERROR("too many texture levels ({}): {}", m_levels.size(), filename);
+    return false;
+  }
+  for (size_t i = 0; i < m_levels.size(); i++) {
+    const auto& level = m_levels[i];
+    int width = std::max(m_levels[0].width >> i, 1);
+    int height = std::max(m_levels[0].height >> i, 1);
+    if (level.width != width || level.height != height ||
+      level.size != m_format.GetLevelSize(width, height)) {
+      SPDLOG_ERROR("invalid texture level {} ({}x{}, {} bytes): {}",
+        i, level.width, level.height, level.size, filename);
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t TextureFile::GetDataSize() const {
+  size_t size = 0;
+  for (const auto& level : m_levels)
+    size += level.size;
+  return size;
+}
+
+// page마다 한 byte씩 읽으면 OS가 해당 page를 파일에서 채움
+void TextureFile::Prefetch() const {
+  constexpr size_t PAGE_SIZE = 4096;
+  volatile uint8_t sink = 0;
+  for (const auto& level : m_levels) {
+    auto data = (const uint8_t*)level.data;
+    for (size_t offset = 0; offset < level.size; offset += PAGE_SIZE)
+      sink = sink + data[offset];
+  }
+}
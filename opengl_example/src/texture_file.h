@@ -0,0 +1,70 @@
+#ifndef __TEXTURE_FILE_H__
+#define __TEXTURE_FILE_H__
+
+#include "common.h"
+#include "mapped_file.h"
+#include <vector>
+
+// GPU에 그대로 올릴 texel 형식
+struct TextureFormat {
+  uint32_t internalFormat { GL_RGBA8 };
+  // glTexImage2D()의 format / type (block 압축 형식이면 0)
+  uint32_t format { 0 };
+  uint32_t type { 0 };
+  // 압축 형식이면 4x4 block 하나, 아니면 texel 하나의 byte 수
+  uint32_t blockSize { 0 };
+
+  bool IsCompressed() const { return format == 0; }
+  size_t GetLevelSize(int width, int height) const {
+    if (IsCompressed())
+      return (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+    return (size_t)width * height * blockSize;
+  }
+};
+
+// 이미 GPU 형식으로 준비된 mip level 하나 (data는 upload하는 동안만 유효하면 됨)
+struct TextureLevelData {
+  int width { 0 };
+  int height { 0 };
+  const void* data { nullptr };
+  size_t size { 0 };
+};
+
+/*
+** GPU 형식 texture container 파일 (.dds / .ktx2)
+  stb decode, mipmap 생성 없이 파일에 든 level을 그대로 glTexImage2D()에 넘긴다
+  - 2D texture 하나만 (cube map, array, volume, KTX2 supercompression은 지원하지 않음)
+  - header의 크기 / level 범위는 모두 파일 안에 있는지 확인한 뒤에 사용
+  - level은 저장된 줄 순서 그대로 mapping된 주소에서 복사 없이 올림 -> 읽는 비용이 파일 I/O뿐
+  - GL은 첫 줄을 v = 0으로 보므로 위 줄부터 저장된 파일(DDS 전부, KTX2 기본 "rd")은
+    IsTopDown()을 Texture에 넘겨 shader가 sampling할 때 v를 뒤집음
+    (BC7, 4의 배수가 아닌 높이 등 어떤 형식이든 data를 고치지 않으므로 방향이 틀릴 일이 없음)
+*/
+CLASS_PTR(TextureFile)
+class TextureFile {
+public:
+  // 확장자로 container 파일인지 판단 (아니면 Image::Load()로 decode할 image)
+  static bool IsTextureFile(const std::string& filename);
+  static TextureFileUPtr Load(const std::string& filename);
+
+  const TextureFormat& GetFormat() const { return m_format; }
+  // 위 줄부터 저장되어 있으면 true (GL 순서로 sampling하려면 v를 뒤집어야 함)
+  bool IsTopDown() const { return m_topDown; }
+  int GetLevelCount() const { return (int)m_levels.size(); }
+  // mapping된 파일 안을 가리킴 (TextureFile이 살아 있는 동안만 유효)
+  const TextureLevelData* GetLevels() const { return m_levels.data(); }
+  size_t GetDataSize() const;
+  // level data의 page를 미리 읽어 둠 (worker thread에서 불러 GL thread가 page fault로 멈추지 않게)
+  void Prefetch() const;
+
+private:
+  TextureFile() {}
+  bool Init(const std::string& filename);
+
+  MappedFileUPtr m_file;
+  TextureFormat m_format;
+  std::vector<TextureLevelData> m_levels;
+  bool m_topDown { false };
+};
+
+#endif // __TEXTURE_FILE_H__
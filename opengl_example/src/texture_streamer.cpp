@@ -0,0 +1,168 @@
+#include "texture_streamer.h"
+#include "gl_state.h"
+#include <algorithm>
+#include <cstring>
+
+TextureStreamerUPtr TextureStreamer::Create(int threadCount, size_t uploadBudget) {
+  auto streamer = TextureStreamerUPtr(new TextureStreamer());
+  if (!streamer->Init(threadCount, uploadBudget))
+    return nullptr;
+  return std::move(streamer);
+}
+
+TextureStreamer::~TextureStreamer() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_requestCondition.notify_all();
+  for (auto& thread : m_threads)
+    thread.join();
+}
+
+// PBO는 frame 3개 분량을 돌려 쓰므로 GPU가 아직 읽고 있는 구역에 덮어쓰지 않음 (Buffer streaming mode)
+bool TextureStreamer::Init(int threadCount, size_t uploadBudget) {
+  if (threadCount <= 0)
+    threadCount = std::clamp((int)std::thread::hardware_concurrency() - 1, 1, 4);
+  m_uploadBudget = uploadBudget;
+  m_pixelBuffer = Buffer::CreateStreaming(GL_PIXEL_UNPACK_BUFFER, uploadBudget);
+  if (!m_pixelBuffer)
+    return false;
+  // 바인딩된 채로 두면 이후 glTexImage2D()가 CPU pointer 대신 PBO에서 읽음
+  GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  m_threads.reserve(threadCount);
+  for (int i = 0; i < threadCount; i++)
+    m_threads.emplace_back([this]() { DecodeLoop(); });
+  return true;
+}
+
+TextureUPtr TextureStreamer::CreatePlaceholder() const {
+  auto image = Image::Create(1, 1, 4);
+  image->SetCheckImage(1, 1);
+  return Texture::CreateFromImage(image.get());
+}
+
+TexturePtr TextureStreamer::Load(const std::string& filepath,
+  const MipmapOptions& mipmapOptions) {
+  TexturePtr texture = CreatePlaceholder();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_requests.push_back({ filepath, mipmapOptions, texture, nullptr, nullptr });
+  }
+  m_requestCondition.notify_one();
+  m_stats.pendingCount++;
+  return texture;
+}
+
+void TextureStreamer::DecodeLoop() {
+  while (true) {
+    Request request;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_requestCondition.wait(lock, [this]() { return m_stop || !m_requests.empty(); });
+      if (m_stop)
+        return;
+      request = std::move(m_requests.front());
+      m_requests.pop_front();
+    }
+    if (TextureFile::IsTextureFile(request.filepath)) {
+      request.file = TextureFile::Load(request.filepath);
+      if (request.file)
+        request.file->Prefetch();
+    }
+    else {
+      request.image = Image::Load(request.filepath);
+    }
+    // GL thread에서 glGenerateMipmap()을 부르지 않도록 level을 모두 여기서 만듦
+    if (request.image) {
+      request.image->SetMipLevels(
+        MipmapGenerator::Generate(request.image.get(), request.mipmapOptions));
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_decoded.push_back(std::move(request));
+    }
+    m_decodedCondition.notify_all();
+  }
+}
+
+void TextureStreamer::Update() {
+  // 올릴 것이 없는 프레임에는 container를 만들지 않음 (매 프레임 heap allocation 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_decoded.empty())
+      return;
+    // budget을 넘는 것은 다음 프레임으로 (decode 순서 유지)
+    size_t uploadSize = 0;
+    while (!m_decoded.empty()) {
+      const auto& front = m_decoded.front();
+      size_t size = front.file ? front.file->GetDataSize() :
+        front.image ? front.image->GetMipChainSize() : 0;
+      if (!m_uploading.empty() && uploadSize + size > m_uploadBudget)
+        break;
+      uploadSize += size;
+      m_uploading.push_back(std::move(m_decoded.front()));
+      m_decoded.pop_front();
+    }
+  }
+
+  m_pixelBuffer->BeginFrame();
+  for (const auto& request : m_uploading)
+    Upload(request);
+  m_pixelBuffer->EndFrame();
+  GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  // capacity는 남겨서 다음 upload 때 다시 씀
+  m_uploading.clear();
+}
+
+void TextureStreamer::Upload(const Request& request) {
+  m_stats.pendingCount--;
+  auto texture = request.texture.lock();
+  if (!texture)
+    return;
+  // 읽지 못한 파일은 placeholder를 그대로 둠 (에러는 Image::Load() / TextureFile에서 출력)
+  if (request.file) {
+    const auto& file = request.file;
+    if (!texture->SetFromFile(file.get())) {
+      m_stats.failedCount++;
+      return;
+    }
+    m_stats.uploadedCount++;
+    m_stats.uploadedBytes += file->GetDataSize();
+    return;
+  }
+  if (!request.image) {
+    m_stats.failedCount++;
+    return;
+  }
+
+  const auto& image = request.image;
+  size_t size = image->GetMipChainSize();
+  auto allocation = m_pixelBuffer->Allocate(size, 4);
+  if (allocation.data) {
+    auto data = (uint8_t*)allocation.data;
+    for (int i = 0; i < image->GetLevelCount(); i++) {
+      auto level = image->GetLevel(i);
+      memcpy(data, level->GetData(), level->GetDataSize());
+      data += level->GetDataSize();
+    }
+    m_pixelBuffer->Commit();
+    texture->SetImageFromPixelBuffer(image.get(), m_pixelBuffer.get(), allocation.offset);
+  }
+  else {
+    texture->SetImage(image.get());
+  }
+  m_stats.uploadedCount++;
+  m_stats.uploadedBytes += size;
+}
+
+void TextureStreamer::Finish() {
+  while (m_stats.pendingCount > 0) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_decodedCondition.wait(lock, [this]() { return !m_decoded.empty(); });
+    }
+    Update();
+  }
+}
@@ -0,0 +1,81 @@
+#ifndef __TEXTURE_STREAMER_H__
+#define __TEXTURE_STREAMER_H__
+
+#include "texture.h"
+#include "mipmap_generator.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct TextureStreamerStats {
+  uint32_t pendingCount { 0 };
+  uint32_t uploadedCount { 0 };
+  uint32_t failedCount { 0 };
+  uint64_t uploadedBytes { 0 };
+};
+
+/*
+** 비동기 texture streaming
+  - Load(): 1x1 placeholder texture를 바로 돌려주고, 파일 decode와 mipmap 생성은 worker thread에서 진행
+  - Update() (GL thread, 매 프레임): decode가 끝난 image를 streaming PBO에 복사해서
+    upload budget(byte) 안에서만 올림 -> 큰 texture가 여러 장 있어도 한 프레임이 길어지지 않음
+    (한 프레임에 최소 한 장은 올리고, budget보다 큰 image는 PBO 없이 직접 올림)
+  - upload가 끝나면 같은 Texture 객체가 실제 image로 바뀌므로 DrawItem 등이 가진 포인터는 그대로 유효
+  - .dds / .ktx2는 decode 없이 worker가 파일을 mapping하고 page만 미리 읽음 (TextureFile)
+    -> GL thread는 PBO 복사 없이 level을 저장된 그대로 올림 (줄 순서는 Texture::IsTopDown())
+  -> 시작 시간이 전체 image 크기와 상관없이 첫 프레임을 바로 그릴 수 있음
+*/
+CLASS_PTR(TextureStreamer)
+class TextureStreamer {
+public:
+  static constexpr size_t DEFAULT_UPLOAD_BUDGET = 4 << 20;
+
+  // threadCount가 0이면 (hardware thread 수 - 1, 최대 4)개의 decode thread 사용
+  static TextureStreamerUPtr Create(int threadCount = 0,
+    size_t uploadBudget = DEFAULT_UPLOAD_BUDGET);
+  ~TextureStreamer();
+
+  // 돌려준 texture를 호출한 쪽이 먼저 없애면 decode 결과는 upload하지 않고 버림
+  // mipmapOptions는 decode하는 image에만 적용 (.dds / .ktx2는 파일에 든 level을 그대로 씀)
+  TexturePtr Load(const std::string& filepath,
+    const MipmapOptions& mipmapOptions = MipmapOptions());
+  void Update();
+  // 요청한 texture가 모두 올라갈 때까지 대기 (headless benchmark처럼 결과가 결정적이어야 할 때)
+  void Finish();
+  const TextureStreamerStats& GetStats() const { return m_stats; }
+
+private:
+  TextureStreamer() {}
+  bool Init(int threadCount, size_t uploadBudget);
+  void DecodeLoop();
+
+  struct Request {
+    std::string filepath;
+    MipmapOptions mipmapOptions;
+    TextureWPtr texture;
+    ImageUPtr image;
+    TextureFileUPtr file;
+  };
+
+  TextureUPtr CreatePlaceholder() const;
+  void Upload(const Request& request);
+
+  // m_mutex가 두 queue와 m_stop을 보호
+  std::mutex m_mutex;
+  std::condition_variable m_requestCondition;
+  std::condition_variable m_decodedCondition;
+  std::deque<Request> m_requests;
+  std::deque<Request> m_decoded;
+  bool m_stop { false };
+  std::vector<std::thread> m_threads;
+  // Update()에서 이번 프레임에 올릴 요청 (GL thread 전용)
+  std::vector<Request> m_uploading;
+
+  BufferUPtr m_pixelBuffer;
+  size_t m_uploadBudget { 0 };
+  TextureStreamerStats m_stats;
+};
+
+#endif // __TEXTURE_STREAMER_H__
@@ -0,0 +1,128 @@
+#include "vertex_compression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+uint16_t FloatToHalf(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = (bits >> 16) & 0x8000;
+  uint32_t exponent = (bits >> 23) & 0xFF;
+  uint32_t mantissa = bits & 0x7FFFFF;
+  // inf / NaN
+  if (exponent == 0xFF)
+    return (uint16_t)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+  int32_t halfExponent = (int32_t)exponent - 127 + 15;
+  if (halfExponent >= 31)
+    return (uint16_t)(sign | 0x7C00);
+  // half의 subnormal: 숨은 1을 살려서 mantissa를 오른쪽으로 밀어냄
+  if (halfExponent <= 0) {
+    if (halfExponent < -10)
+      return (uint16_t)sign;
+    mantissa |= 0x800000;
+    uint32_t shift = (uint32_t)(14 - halfExponent);
+    uint32_t half = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1)))
+      half++;
+    return (uint16_t)(sign | half);
+  }
+  // 반올림으로 mantissa가 넘치면 exponent가 1 올라가는 것까지 그대로 맞음
+  uint32_t half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1FFF;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    half++;
+  return (uint16_t)(sign | half);
+}
+
+glm::vec2 OctahedralEncode(const glm::vec3& normal) {
+  float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+  if (sum == 0.0f)
+    return glm::vec2(0.0f);
+  auto n = normal / sum;
+  if (n.z >= 0.0f)
+    return glm::vec2(n.x, n.y);
+  // 아래쪽 반구는 팔면체의 바깥 삼각형으로 접어 넣음
+  return glm::vec2(
+    (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+    (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+}
+
+// GL의 snorm 복원 식: max(q / (2^(bits-1) - 1), -1)
+static int32_t QuantizeSnorm(float value, int bits) {
+  float maxValue = (float)((1 << (bits - 1)) - 1);
+  return (int32_t)std::lround(std::clamp(value, -1.0f, 1.0f) * maxValue);
+}
+
+static void Quantize(Snorm16x4& out, const glm::vec3& value) {
+  for (int c = 0; c < 3; c++)
+    out.values[c] = (int16_t)QuantizeSnorm(value[c], 16);
+  out.values[3] = 0;
+}
+static void Quantize(Snorm16x3& out, const glm::vec3& value) {
+  for (int c = 0; c < 3; c++)
+    out.values[c] = (int16_t)QuantizeSnorm(value[c], 16);
+}
+static void Quantize(Snorm16x2& out, const glm::vec2& value) {
+  for (int c = 0; c < 2; c++)
+    out.values[c] = (int16_t)QuantizeSnorm(value[c], 16);
+}
+static void Quantize(Snorm8x2& out, const glm::vec2& value) {
+  for (int c = 0; c < 2; c++)
+    out.values[c] = (int8_t)QuantizeSnorm(value[c], 8);
+}
+
+template <typename Vertex>
+static std::vector<uint8_t> PackVertices(const MeshVertex* source, size_t vertexCount,
+  const glm::vec3& positionScale, const glm::vec3& positionOffset) {
+  std::vector<uint8_t> vertices(sizeof(Vertex) * vertexCount);
+  for (size_t i = 0; i < vertexCount; i++) {
+    Vertex vertex;
+    Quantize(vertex.position, (source[i].position - positionOffset) / positionScale);
+    Quantize(vertex.normal, OctahedralEncode(source[i].normal));
+    vertex.texCoord.values[0] = FloatToHalf(source[i].texCoord.x);
+    vertex.texCoord.values[1] = FloatToHalf(source[i].texCoord.y);
+    memcpy(vertices.data() + sizeof(Vertex) * i, &vertex, sizeof(Vertex));
+  }
+  return vertices;
+}
+
+bool CompressVertices(MeshData& mesh, NormalEncoding normalEncoding) {
+  if (mesh.GetVertexFormat() != VertexFormatOf<MeshVertex>::value) {
+    SPDLOG_ERROR("vertex compression needs the float MeshVertex layout");
+    return false;
+  }
+  size_t vertexCount = mesh.GetVertexCount();
+  auto source = (const MeshVertex*)mesh.vertices.data();
+
+  // bounding box 중심 / 반 크기로 [-1, 1]에 맞춤 (크기가 0인 축은 1로)
+  glm::vec3 minPos(0.0f);
+  glm::vec3 maxPos(0.0f);
+  if (vertexCount > 0) {
+    minPos = maxPos = source[0].position;
+    for (size_t i = 1; i < vertexCount; i++) {
+      minPos = glm::min(minPos, source[i].position);
+      maxPos = glm::max(maxPos, source[i].position);
+    }
+  }
+  glm::vec3 offset = (minPos + maxPos) * 0.5f;
+  glm::vec3 scale = (maxPos - minPos) * 0.5f;
+  for (int c = 0; c < 3; c++) {
+    if (scale[c] <= 0.0f)
+      scale[c] = 1.0f;
+  }
+
+  if (normalEncoding == NormalEncoding::Octahedral8) {
+    mesh.vertices = PackVertices<CompressedVertex8>(source, vertexCount, scale, offset);
+    mesh.SetVertexFormat(VertexFormatOf<CompressedVertex8>::value);
+  }
+  else {
+    mesh.vertices = PackVertices<CompressedVertex16>(source, vertexCount, scale, offset);
+    mesh.SetVertexFormat(VertexFormatOf<CompressedVertex16>::value);
+  }
+  mesh.positionScale = scale;
+  mesh.positionOffset = offset;
+  return true;
+}
@@ -0,0 +1,63 @@
+#ifndef __VERTEX_COMPRESSION_H__
+#define __VERTEX_COMPRESSION_H__
+
+#include "common.h"
+#include "mesh_data.h"
+
+/*
+** 압축 정점 형식 (float 32byte -> 16byte / 12byte)
+  - position: mesh bounding box 기준 16bit snorm
+    -> shader에서 position = aPos * positionScale + positionOffset (mesh 별 uniform)
+  - normal: octahedral encoding (단위 구를 팔면체에 투영한 뒤 평면으로 펼침) 2 x 16bit / 8bit snorm
+    -> shader에서 다시 3차원으로 펼쳐서 normalize
+  - texCoord: half float 2개
+
+  | 형식    | position      | normal       | texCoord   | stride |
+  | Oct16   | 0: short x 4  | 8: short x 2 | 12: half x 2 | 16 |
+  | Oct8    | 0: short x 3  | 6: byte x 2  | 8: half x 2  | 12 |
+*/
+struct CompressedVertex16 {
+  Snorm16x4 position; // w는 사용하지 않음 (normal을 4byte 경계에 맞추기 위한 자리)
+  Snorm16x2 normal;
+  Half2 texCoord;
+};
+
+struct CompressedVertex8 {
+  Snorm16x3 position;
+  Snorm8x2 normal;
+  Half2 texCoord;
+};
+
+template <>
+struct VertexFormatOf<CompressedVertex16> {
+  static constexpr VertexFormat value = MakeVertexFormat<CompressedVertex16>(
+    VERTEX_ATTRIB(CompressedVertex16, position, 0),
+    VERTEX_ATTRIB(CompressedVertex16, normal, 1),
+    VERTEX_ATTRIB(CompressedVertex16, texCoord, 2));
+};
+static_assert(VertexFormatOf<CompressedVertex16>::value.stride == 16, "unexpected padding");
+
+template <>
+struct VertexFormatOf<CompressedVertex8> {
+  static constexpr VertexFormat value = MakeVertexFormat<CompressedVertex8>(
+    VERTEX_ATTRIB(CompressedVertex8, position, 0),
+    VERTEX_ATTRIB(CompressedVertex8, normal, 1),
+    VERTEX_ATTRIB(CompressedVertex8, texCoord, 2));
+};
+static_assert(VertexFormatOf<CompressedVertex8>::value.stride == 12, "unexpected padding");
+
+enum class NormalEncoding : uint8_t {
+  Octahedral16 = 0,
+  Octahedral8 = 1,
+};
+
+// MeshData::SetVertices()로 만든 float 형식만 변환 가능 (아니면 false)
+// index 최적화(MeshOptimizer)는 float position이 필요하므로 그 뒤에 호출
+bool CompressVertices(MeshData& mesh, NormalEncoding normalEncoding);
+
+// IEEE 754 half (round to nearest even)
+uint16_t FloatToHalf(float value);
+// 단위 벡터 -> [-1, 1]^2
+glm::vec2 OctahedralEncode(const glm::vec3& normal);
+
+#endif // __VERTEX_COMPRESSION_H__
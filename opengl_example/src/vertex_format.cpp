@@ -0,0 +1,13 @@
+#include "vertex_format.h"
+
+uint32_t MeshAttrib::GetSize() const {
+  switch (type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE: return count;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT: return count * 2;
+    case GL_FLOAT: return count * 4;
+    default: return 0;
+  }
+}
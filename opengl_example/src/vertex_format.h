@@ -0,0 +1,172 @@
+#ifndef __VERTEX_FORMAT_H__
+#define __VERTEX_FORMAT_H__
+
+#include "common.h"
+#include <cstddef>
+
+// VertexLayout::SetVertexBuffer()가 VAO에 설정하는 정점 attribute 하나의 설명
+// (mesh 파일 header에도 이 구조 그대로 저장되므로 모두 4byte 정수)
+struct MeshAttrib {
+  uint32_t attribIndex { 0 };
+  uint32_t count { 0 };
+  uint32_t type { GL_FLOAT };
+  uint32_t normalized { GL_FALSE };
+  uint32_t offset { 0 };
+
+  // byte 크기 (GL_FLOAT, GL_HALF_FLOAT, 8/16bit 정수가 아니면 0)
+  uint32_t GetSize() const;
+};
+
+// 압축 정점용 저장 타입: shader에서는 [-1, 1] float (snorm) / float (half)로 읽힘
+struct Snorm8x2 { int8_t values[2]; };
+struct Snorm16x2 { int16_t values[2]; };
+struct Snorm16x3 { int16_t values[3]; };
+struct Snorm16x4 { int16_t values[4]; };
+struct Half2 { uint16_t values[2]; };
+
+/*
+** C++ 타입 -> glVertexAttribPointer() 인자
+  - count, type, normalized: attribute 하나의 형식
+  - columns: 차지하는 location 수 (mat4는 vec4 4개 -> location 4개)
+  - columnStride: 다음 location의 byte 간격
+  새 타입을 정점에 쓰려면 여기에 특수화를 추가 (없으면 컴파일 에러)
+*/
+template <typename T>
+struct VertexAttribTraits;
+
+template <uint32_t Count, uint32_t Type, bool Normalized,
+  uint32_t Columns = 1, uint32_t ColumnStride = 0>
+struct VertexAttribTraitsBase {
+  static constexpr uint32_t count = Count;
+  static constexpr uint32_t type = Type;
+  static constexpr bool normalized = Normalized;
+  static constexpr uint32_t columns = Columns;
+  static constexpr uint32_t columnStride = ColumnStride;
+};
+
+template <> struct VertexAttribTraits<float> : VertexAttribTraitsBase<1, GL_FLOAT, false> {};
+template <> struct VertexAttribTraits<glm::vec2> : VertexAttribTraitsBase<2, GL_FLOAT, false> {};
+template <> struct VertexAttribTraits<glm::vec3> : VertexAttribTraitsBase<3, GL_FLOAT, false> {};
+template <> struct VertexAttribTraits<glm::vec4> : VertexAttribTraitsBase<4, GL_FLOAT, false> {};
+template <> struct VertexAttribTraits<glm::mat4>
+  : VertexAttribTraitsBase<4, GL_FLOAT, false, 4, sizeof(glm::vec4)> {};
+template <> struct VertexAttribTraits<Snorm8x2> : VertexAttribTraitsBase<2, GL_BYTE, true> {};
+template <> struct VertexAttribTraits<Snorm16x2> : VertexAttribTraitsBase<2, GL_SHORT, true> {};
+template <> struct VertexAttribTraits<Snorm16x3> : VertexAttribTraitsBase<3, GL_SHORT, true> {};
+template <> struct VertexAttribTraits<Snorm16x4> : VertexAttribTraitsBase<4, GL_SHORT, true> {};
+template <> struct VertexAttribTraits<Half2> : VertexAttribTraitsBase<2, GL_HALF_FLOAT, false> {};
+
+// 정점 struct의 member 하나 (columns개의 MeshAttrib으로 펼쳐짐)
+struct VertexAttribDesc {
+  uint32_t attribIndex;
+  uint32_t count;
+  uint32_t type;
+  bool normalized;
+  uint32_t offset;
+  uint32_t columns;
+  uint32_t columnStride;
+};
+
+template <typename T>
+constexpr VertexAttribDesc MakeVertexAttrib(uint32_t attribIndex, size_t offset) {
+  using Traits = VertexAttribTraits<T>;
+  return { attribIndex, Traits::count, Traits::type, Traits::normalized,
+    (uint32_t)offset, Traits::columns, Traits::columnStride };
+}
+
+// ex) VERTEX_ATTRIB(MeshVertex, normal, 1): member 타입에서 형식, offsetof()로 위치를 얻음
+#define VERTEX_ATTRIB(Vertex, member, attribIndex) \
+  MakeVertexAttrib<decltype(Vertex::member)>(attribIndex, offsetof(Vertex, member))
+
+/*
+** 정점 하나의 attribute 전체 (stride 포함)
+  - 정점 struct에서 MakeVertexFormat<Vertex>(...)로 컴파일 타임에 만들거나
+    mesh 파일 header처럼 실행 중에 읽은 attribute로 MakeVertexFormat(stride, ...)
+  - hash는 VAO cache의 key (VertexLayoutCache)
+*/
+struct VertexFormat {
+  static constexpr uint32_t MAX_ATTRIB_COUNT = 16;
+
+  uint32_t stride { 0 };
+  uint32_t attribCount { 0 };
+  MeshAttrib attribs[MAX_ATTRIB_COUNT] {};
+  uint32_t hash { 0 };
+};
+
+// FNV-1a (HashUniformName과 같은 방식)
+constexpr uint32_t HashVertexFormat(const VertexFormat& format) {
+  uint32_t hash = 2166136261u;
+  auto mix = [&hash](uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+      hash ^= (value >> (i * 8)) & 0xFF;
+      hash *= 16777619u;
+    }
+  };
+  mix(format.stride);
+  mix(format.attribCount);
+  for (uint32_t i = 0; i < format.attribCount; i++) {
+    const auto& attrib = format.attribs[i];
+    mix(attrib.attribIndex);
+    mix(attrib.count);
+    mix(attrib.type);
+    mix(attrib.normalized);
+    mix(attrib.offset);
+  }
+  return hash;
+}
+
+constexpr bool operator==(const VertexFormat& a, const VertexFormat& b) {
+  if (a.hash != b.hash || a.stride != b.stride || a.attribCount != b.attribCount)
+    return false;
+  for (uint32_t i = 0; i < a.attribCount; i++) {
+    const auto& x = a.attribs[i];
+    const auto& y = b.attribs[i];
+    if (x.attribIndex != y.attribIndex || x.count != y.count || x.type != y.type ||
+      x.normalized != y.normalized || x.offset != y.offset)
+      return false;
+  }
+  return true;
+}
+
+constexpr bool operator!=(const VertexFormat& a, const VertexFormat& b) {
+  return !(a == b);
+}
+
+// attribute가 MAX_ATTRIB_COUNT를 넘으면 배열 범위를 벗어나므로 constexpr 변수에서는 컴파일 에러
+template <typename Vertex, typename... Attribs>
+constexpr VertexFormat MakeVertexFormat(Attribs... attribs) {
+  const VertexAttribDesc descs[] = { attribs... };
+  VertexFormat format;
+  format.stride = sizeof(Vertex);
+  for (const auto& desc : descs) {
+    for (uint32_t column = 0; column < desc.columns; column++) {
+      auto& attrib = format.attribs[format.attribCount++];
+      attrib.attribIndex = desc.attribIndex + column;
+      attrib.count = desc.count;
+      attrib.type = desc.type;
+      attrib.normalized = desc.normalized ? GL_TRUE : GL_FALSE;
+      attrib.offset = desc.offset + desc.columnStride * column;
+    }
+  }
+  format.hash = HashVertexFormat(format);
+  return format;
+}
+
+constexpr VertexFormat MakeVertexFormat(uint32_t stride, const MeshAttrib* attribs,
+  uint32_t attribCount) {
+  VertexFormat format;
+  format.stride = stride;
+  for (uint32_t i = 0; i < attribCount && i < VertexFormat::MAX_ATTRIB_COUNT; i++)
+    format.attribs[format.attribCount++] = attribs[i];
+  format.hash = HashVertexFormat(format);
+  return format;
+}
+
+// 정점 struct 별 format: 특수화해서 value를 정의
+// ex) template <> struct VertexFormatOf<MeshVertex> {
+//       static constexpr VertexFormat value = MakeVertexFormat<MeshVertex>(...);
+//     };
+template <typename Vertex>
+struct VertexFormatOf;
+
+#endif // __VERTEX_FORMAT_H__
@@ -1,4 +1,7 @@
 #include "vertex_layout.h"
+#include "gl_state.h"
+#include <algorithm>
+#include <vector>
 
 VertexLayoutUPtr VertexLayout::Create() {
   auto vertexLayout = VertexLayoutUPtr(new VertexLayout());
@@ -9,24 +12,193 @@ VertexLayoutUPtr VertexLayout::Create() {
 VertexLayout::~VertexLayout() {
   if (m_vertexArrayObject) {
     glDeleteVertexArrays(1, &m_vertexArrayObject);
+    GLState::ForgetVertexArray(m_vertexArrayObject);
   }
 }
 
 void VertexLayout::Bind() const {
-  glBindVertexArray(m_vertexArrayObject);
+  GLState::BindVertexArray(m_vertexArrayObject);
 }
 
+/*
+glVertexAttribDivisor(n, divisor):
+  - 0: 정점마다 다음 값을 읽음 (기본값)
+  - 1 이상: divisor개의 instance를 그릴 때마다 다음 값을 읽음
+  -> glDrawElementsInstanced()로 instance 별 데이터(model matrix 등) 전달
+*/
 void VertexLayout::SetAttrib(
   uint32_t attribIndex, int count,
   uint32_t type, bool normalized,
-  size_t stride, uint64_t offset) const {
+  size_t stride, uint64_t offset,
+  uint32_t divisor) const {
   
   glEnableVertexAttribArray(attribIndex);
   glVertexAttribPointer(attribIndex, count, type, normalized, stride, (const void*)offset);
+  glVertexAttribDivisor(attribIndex, divisor);
+}
+
+/*
+** VAO 설정 (GLState::HasDirectStateAccess()이면 DSA)
+  - glVertexArrayAttribFormat(vao, attrib, count, type, normalized, relativeOffset):
+    attribute의 형식과 정점 안의 위치
+  - glVertexArrayAttribBinding(vao, attrib, binding): attribute가 읽을 binding point
+  - glVertexArrayVertexBuffer(vao, binding, buffer, offset, stride): binding point에 buffer 연결
+  - glVertexArrayBindingDivisor(vao, binding, divisor): binding point 단위의 instance divisor
+  -> VAO를 바인딩하지 않고 설정하므로 그리는 중인 VAO 상태를 건드리지 않음
+  DSA가 없으면 VAO를 바인딩한 뒤 glVertexAttribPointer()로 설정 (binding point = attribute)
+*/
+void VertexLayout::SetVertexBuffer(uint32_t bindingIndex, uint32_t buffer,
+  const VertexFormat& format, uint64_t offset, uint32_t divisor) const {
+  if (GLState::HasDirectStateAccess()) {
+    for (uint32_t i = 0; i < format.attribCount; i++) {
+      const auto& attrib = format.attribs[i];
+      glEnableVertexArrayAttrib(m_vertexArrayObject, attrib.attribIndex);
+      glVertexArrayAttribFormat(m_vertexArrayObject, attrib.attribIndex,
+        attrib.count, attrib.type, attrib.normalized, attrib.offset);
+      glVertexArrayAttribBinding(m_vertexArrayObject, attrib.attribIndex, bindingIndex);
+    }
+    glVertexArrayVertexBuffer(m_vertexArrayObject, bindingIndex, buffer,
+      offset, format.stride);
+    glVertexArrayBindingDivisor(m_vertexArrayObject, bindingIndex, divisor);
+    return;
+  }
+
+  Bind();
+  GLState::BindBuffer(GL_ARRAY_BUFFER, buffer);
+  for (uint32_t i = 0; i < format.attribCount; i++) {
+    const auto& attrib = format.attribs[i];
+    SetAttrib(attrib.attribIndex, attrib.count, attrib.type, attrib.normalized,
+      format.stride, offset + attrib.offset, divisor);
+  }
+}
 
+void VertexLayout::SetIndexBuffer(uint32_t buffer) const {
+  if (GLState::HasDirectStateAccess()) {
+    glVertexArrayElementBuffer(m_vertexArrayObject, buffer);
+    return;
+  }
+  // GL_ELEMENT_ARRAY_BUFFER binding은 바인딩된 VAO에 저장됨
+  Bind();
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
 }
 
+void VertexLayout::DisableAttrib(int attribIndex) const {
+  if (GLState::HasDirectStateAccess()) {
+    glDisableVertexArrayAttrib(m_vertexArrayObject, attribIndex);
+    return;
+  }
+  Bind();
+  glDisableVertexAttribArray(attribIndex);
+}
+
+// glCreateVertexArrays(): 이름과 함께 VAO 객체도 바로 만듦 (바인딩 없이 DSA 함수로 설정 가능)
 void VertexLayout::Init() {
+  if (GLState::HasDirectStateAccess()) {
+    glCreateVertexArrays(1, &m_vertexArrayObject);
+    return;
+  }
   glGenVertexArrays(1, &m_vertexArrayObject);
   Bind();
-}
\ No newline at end of file
+}
+
+namespace {
+
+struct CacheEntry {
+  uint64_t key { 0 };
+  uint32_t bindingCount { 0 };
+  // format은 복사해서 보관 (호출한 쪽의 format 변수보다 오래 살 수 있음)
+  VertexFormat formats[VertexLayoutCache::MAX_BINDING_COUNT];
+  VertexBufferBinding bindings[VertexLayoutCache::MAX_BINDING_COUNT];
+  uint32_t indexBuffer { 0 };
+  VertexLayoutUPtr layout;
+
+  bool Matches(std::initializer_list<VertexBufferBinding> other, uint32_t otherIndexBuffer) const {
+    if (indexBuffer != otherIndexBuffer || bindingCount != other.size())
+      return false;
+    uint32_t i = 0;
+    for (const auto& binding : other) {
+      if (bindings[i].buffer != binding.buffer || bindings[i].offset != binding.offset ||
+        bindings[i].divisor != binding.divisor || formats[i] != *binding.format)
+        return false;
+      i++;
+    }
+    return true;
+  }
+};
+
+std::vector<CacheEntry> s_entries;
+VertexLayoutCacheStats s_stats;
+
+uint64_t MixKey(uint64_t key, uint64_t value) {
+  key ^= value + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2);
+  return key;
+}
+
+uint64_t MakeKey(std::initializer_list<VertexBufferBinding> bindings, uint32_t indexBuffer) {
+  uint64_t key = MixKey(0, indexBuffer);
+  for (const auto& binding : bindings) {
+    key = MixKey(key, binding.format->hash);
+    key = MixKey(key, binding.buffer);
+    key = MixKey(key, binding.offset);
+    key = MixKey(key, binding.divisor);
+  }
+  return key;
+}
+
+} // namespace
+
+const VertexLayout* VertexLayoutCache::Get(std::initializer_list<VertexBufferBinding> bindings,
+  uint32_t indexBuffer) {
+  if (bindings.size() == 0 || bindings.size() > MAX_BINDING_COUNT) {
+    SPDLOG_ERROR("invalid vertex buffer binding count: {}", bindings.size());
+    return nullptr;
+  }
+  uint64_t key = MakeKey(bindings, indexBuffer);
+  for (const auto& entry : s_entries) {
+    if (entry.key == key && entry.Matches(bindings, indexBuffer)) {
+      s_stats.hitCount++;
+      return entry.layout.get();
+    }
+  }
+
+  s_stats.missCount++;
+  CacheEntry entry;
+  entry.key = key;
+  entry.indexBuffer = indexBuffer;
+  entry.layout = VertexLayout::Create();
+  for (const auto& binding : bindings) {
+    entry.formats[entry.bindingCount] = *binding.format;
+    entry.bindings[entry.bindingCount] = binding;
+    entry.bindings[entry.bindingCount].format = nullptr;
+    entry.layout->SetVertexBuffer(entry.bindingCount, binding.buffer, *binding.format,
+      binding.offset, binding.divisor);
+    entry.bindingCount++;
+  }
+  entry.layout->SetIndexBuffer(indexBuffer);
+  s_entries.push_back(std::move(entry));
+  s_stats.layoutCount = (uint32_t)s_entries.size();
+  return s_entries.back().layout.get();
+}
+
+void VertexLayoutCache::ForgetBuffer(uint32_t buffer) {
+  auto uses = [buffer](const CacheEntry& entry) {
+    if (entry.indexBuffer == buffer)
+      return true;
+    for (uint32_t i = 0; i < entry.bindingCount; i++) {
+      if (entry.bindings[i].buffer == buffer)
+        return true;
+    }
+    return false;
+  };
+  s_entries.erase(std::remove_if(s_entries.begin(), s_entries.end(), uses), s_entries.end());
+  s_stats.layoutCount = (uint32_t)s_entries.size();
+}
+
+void VertexLayoutCache::Clear() {
+  s_entries.clear();
+  s_stats.layoutCount = 0;
+}
+
+const VertexLayoutCacheStats& VertexLayoutCache::GetStats() {
+  return s_stats;
+}
@@ -2,6 +2,8 @@
 #define __VERTEX_LAYOUT_H__
 
 #include "common.h"
+#include "vertex_format.h"
+#include <initializer_list>
 
 CLASS_PTR(VertexLayout)
 class VertexLayout {
@@ -11,16 +13,62 @@ public:
 
   uint32_t Get() const { return m_vertexArrayObject; }
   void Bind() const;
-  void SetAttrib(
-    uint32_t attribIndex, int count,
-    uint32_t type, bool normalized,
-    size_t stride, uint64_t offset) const;
+  // vertex buffer 하나를 binding point에 연결하고 format의 attribute를 모두 설정
+  // (offset: buffer 처음부터 첫 정점까지의 byte,
+  //  divisor가 0이 아니면 instance attribute: divisor개 instance마다 다음 값으로 진행)
+  void SetVertexBuffer(uint32_t bindingIndex, uint32_t buffer, const VertexFormat& format,
+    uint64_t offset = 0, uint32_t divisor = 0) const;
+  void SetIndexBuffer(uint32_t buffer) const;
   void DisableAttrib(int attribIndex) const;
 private:
   VertexLayout() {}
   void Init();
+  // DSA가 없을 때: 바인딩된 VAO와 GL_ARRAY_BUFFER로 attribute 하나를 설정
+  void SetAttrib(
+    uint32_t attribIndex, int count,
+    uint32_t type, bool normalized,
+    size_t stride, uint64_t offset,
+    uint32_t divisor = 0) const;
   uint32_t m_vertexArrayObject { 0 };
 };
 
+// VAO에 연결할 vertex buffer 하나와 그 안의 정점 형식
+struct VertexBufferBinding {
+  const VertexFormat* format { nullptr };
+  uint32_t buffer { 0 };
+  uint64_t offset { 0 };
+  uint32_t divisor { 0 };
+};
+
+/*
+** VAO cache
+  VAO의 상태 = (정점 형식, vertex buffer, offset, divisor) 목록 + index buffer
+  -> 같은 조합을 다시 요청하면 이미 설정해 둔 VAO를 돌려주고, 처음이면 만들어서 attribute 설정
+  - GL context는 하나뿐이므로 GLState처럼 static 함수로만 접근
+  - buffer 이름은 삭제 후 재사용될 수 있으므로 Buffer 소멸자에서 ForgetBuffer()로
+    그 buffer를 쓰는 VAO를 같이 지운다
+  - GL context를 없애기 전에 Clear()
+*/
+struct VertexLayoutCacheStats {
+  uint32_t layoutCount { 0 };
+  uint64_t hitCount { 0 };
+  uint64_t missCount { 0 };
+};
+
+class VertexLayoutCache {
+public:
+  static constexpr uint32_t MAX_BINDING_COUNT = 4;
+
+  // 돌려준 VAO는 cache가 소유 (연결된 buffer가 삭제되거나 Clear() 전까지 유효)
+  static const VertexLayout* Get(std::initializer_list<VertexBufferBinding> bindings,
+    uint32_t indexBuffer);
+  static void ForgetBuffer(uint32_t buffer);
+  static void Clear();
+  static const VertexLayoutCacheStats& GetStats();
+
+private:
+  VertexLayoutCache() = delete;
+};
+
 
 #endif // __VERTEX_LAYOUT_H__
\ No newline at end of file